@@ -0,0 +1,384 @@
+// Headless benchmark for the Life engines
+// Runs the same random soup through every available engine and reports
+// throughput, wall time, peak memory and a checksum of the final state as JSON.
+//
+// Usage: life_bench [--rows N] [--cols N] [--density D] [--seed S]
+//                   [--generations G] [--threads T] [--engines a,b,...]
+//
+// Each engine runs in its own child process so its peak RSS is not inflated
+// by the engines before it. JSON goes to stdout, a readable summary to stderr.
+// Process isolation and peak RSS are POSIX only; on Windows the engines run
+// in this process one after another and peak RSS is reported as null.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include "../Life_Engine/simd_kernels.hpp"
+#include "../Life_Engine/parallel_step.hpp"
+#include "../Life_Engine/temporal_blocking.hpp"
+#include "../Life_Engine/active_tiles.hpp"
+#include "../Life_Engine/generation_ring.hpp"
+#include "../Life_Engine/hashlife.hpp"
+#include "../Life_Engine/sparse_universe.hpp"
+using namespace std;
+
+// Benchmark defaults
+const int DEFAULT_ROWS = 1024;
+const int DEFAULT_COLS = 1024;
+const double DEFAULT_DENSITY = 0.3;
+const unsigned DEFAULT_SEED = 42;
+const int DEFAULT_GENERATIONS = 200;
+
+const char* const ALL_ENGINES[] = {
+    "reference", "portable", "sse2", "avx2", "avx512",
+    "parallel", "blocked", "active-tiles", "hashlife", "sparse"
+};
+
+struct BenchConfig {
+    int rows = DEFAULT_ROWS;
+    int cols = DEFAULT_COLS;
+    double density = DEFAULT_DENSITY;
+    unsigned seed = DEFAULT_SEED;
+    int generations = DEFAULT_GENERATIONS;
+    int threads = 0;
+    vector<string> engines;
+};
+
+// What a child process reports back for one engine
+struct EngineResult {
+    bool ran = false;
+    double wallSeconds = 0;
+    uint64_t checksum = 0;
+    long long population = 0;
+    char skipReason[96] = "";
+};
+
+struct EngineReport {
+    string engine;
+    EngineResult result;
+    long peakRssKb = -1;  // -1 when it could not be measured
+};
+
+// Function declarations
+bool parseArgs(int argc, char* argv[], BenchConfig& config);
+BitGrid makeSoup(const BenchConfig& config);
+EngineResult runEngine(const string& engine, const BitGrid& soup, const BenchConfig& config);
+bool runIsolated(const string& engine, const BitGrid& soup, const BenchConfig& config, EngineReport& report);
+bool isTorusEngine(const string& engine);
+string toHex(uint64_t value);
+void printJson(const BenchConfig& config, const vector<EngineReport>& reports);
+void printSummary(const BenchConfig& config, const vector<EngineReport>& reports);
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        cerr << "Usage: life_bench [--rows N] [--cols N] [--density D] [--seed S]\n"
+             << "                  [--generations G] [--threads T] [--engines a,b,...]\n"
+             << "Engines:";
+        for (const char* engine : ALL_ENGINES) {
+            cerr << " " << engine;
+        }
+        cerr << "\n";
+        return 2;
+    }
+
+    BitGrid soup = makeSoup(config);
+
+    vector<EngineReport> reports;
+    for (const string& engine : config.engines) {
+        EngineReport report;
+        report.engine = engine;
+        if (!runIsolated(engine, soup, config, report)) {
+            cerr << "Engine " << engine << " crashed\n";
+            return 1;
+        }
+        reports.push_back(report);
+    }
+
+    printSummary(config, reports);
+    printJson(config, reports);
+    return 0;
+}
+
+bool parseArgs(int argc, char* argv[], BenchConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        string value = argv[++i];
+        if (arg == "--rows") {
+            config.rows = atoi(value.c_str());
+        } else if (arg == "--cols") {
+            config.cols = atoi(value.c_str());
+        } else if (arg == "--density") {
+            config.density = atof(value.c_str());
+        } else if (arg == "--seed") {
+            config.seed = static_cast<unsigned>(strtoul(value.c_str(), nullptr, 10));
+        } else if (arg == "--generations") {
+            config.generations = atoi(value.c_str());
+        } else if (arg == "--threads") {
+            config.threads = atoi(value.c_str());
+        } else if (arg == "--engines") {
+            stringstream list(value);
+            string engine;
+            while (getline(list, engine, ',')) {
+                config.engines.push_back(engine);
+            }
+        } else {
+            return false;
+        }
+    }
+
+    if (config.engines.empty()) {
+        config.engines.assign(begin(ALL_ENGINES), end(ALL_ENGINES));
+    }
+    for (const string& engine : config.engines) {
+        bool known = false;
+        for (const char* name : ALL_ENGINES) {
+            known = known || engine == name;
+        }
+        if (!known) {
+            cerr << "Unknown engine: " << engine << "\n";
+            return false;
+        }
+    }
+    return config.rows > 0 && config.cols > 0 && config.generations >= 0 &&
+           config.density >= 0.0 && config.density <= 1.0;
+}
+
+BitGrid makeSoup(const BenchConfig& config) {
+    mt19937 gen(config.seed);
+    bernoulli_distribution alive(config.density);
+    BitGrid soup(config.rows, config.cols);
+    for (int i = 0; i < config.rows; i++) {
+        for (int j = 0; j < config.cols; j++) {
+            soup.set(i, j, alive(gen));
+        }
+    }
+    return soup;
+}
+
+// Step the soup through one engine and time only the generations themselves
+EngineResult runEngine(const string& engine, const BitGrid& soup, const BenchConfig& config) {
+    EngineResult result;
+    auto skip = [&](const char* reason) {
+        snprintf(result.skipReason, sizeof(result.skipReason), "%s", reason);
+        return result;
+    };
+
+    BitGrid current = soup;
+    BitGrid next(config.rows, config.cols);
+    chrono::steady_clock::time_point start;
+
+    if (engine == "reference") {
+        start = chrono::steady_clock::now();
+        for (int g = 0; g < config.generations; g++) {
+            life::stepReference(current, next);
+            swap(current, next);
+        }
+    } else if (engine == "portable" || engine == "sse2" || engine == "avx2" || engine == "avx512") {
+        life::SimdLevel level = engine == "portable" ? life::SimdLevel::PORTABLE
+                              : engine == "sse2" ? life::SimdLevel::SSE2
+                              : engine == "avx2" ? life::SimdLevel::AVX2
+                              : life::SimdLevel::AVX512;
+        if (!life::simdLevelSupported(level)) {
+            return skip("not supported on this CPU");
+        }
+        life::StepRegionFn kernel = life::stepRegionFor(level);
+        start = chrono::steady_clock::now();
+        for (int g = 0; g < config.generations; g++) {
+            kernel(current, next, 0, config.rows, 0, current.getWordsPerRow());
+            swap(current, next);
+        }
+    } else if (engine == "parallel") {
+        ThreadPool pool(config.threads);
+        start = chrono::steady_clock::now();
+        for (int g = 0; g < config.generations; g++) {
+            life::stepParallel(current, next, pool);
+            swap(current, next);
+        }
+    } else if (engine == "blocked") {
+        ThreadPool pool(config.threads);
+        TemporalBlocker blocker;
+        life::RuleKernel kernel = life::fastRuleKernel(life::CONWAY);
+        start = chrono::steady_clock::now();
+        blocker.advance(current, next, config.generations, &pool, kernel);
+    } else if (engine == "active-tiles") {
+        ThreadPool pool(config.threads);
+        GenerationRing history(GenerationRing::DEFAULT_DEPTH, config.rows, config.cols);
+        ActiveTileTracker tracker(config.rows, config.cols);
+        tracker.setRingDepth(history.getDepth());
+        history.reset(life::hashGrid(current));
+        start = chrono::steady_clock::now();
+        for (int g = 0; g < config.generations; g++) {
+            tracker.step(current, history.nextSlot(), &pool);
+            history.advance(current, history.getCurrentHash() ^ tracker.getHashDelta());
+        }
+    } else if (engine == "hashlife") {
+        if (!HashLife::supportsTorus(config.rows, config.cols)) {
+            return skip("needs a square power-of-two board of at least 16x16");
+        }
+        HashLife hashLife;
+        start = chrono::steady_clock::now();
+        hashLife.loadTorus(current);
+        hashLife.stepTorus(static_cast<uint64_t>(config.generations));
+        hashLife.storeTorus(current);
+    } else if (engine == "sparse") {
+        // Runs on the unbounded plane, so only matches the torus engines until
+        // activity reaches the board edge; the checksum covers the original window
+        SparseUniverse universe;
+        universe.loadFrom(soup, 0, 0);
+        start = chrono::steady_clock::now();
+        for (int g = 0; g < config.generations; g++) {
+            universe.step();
+        }
+        result.wallSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        universe.extract(current, 0, 0);
+        result.ran = true;
+        result.checksum = life::hashGrid(current);
+        result.population = universe.getPopulation();
+        return result;
+    }
+
+    result.wallSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    result.ran = true;
+    result.checksum = life::hashGrid(current);
+    result.population = current.popcount();
+    return result;
+}
+
+// Run one engine in a child process and collect its result and peak RSS
+bool runIsolated(const string& engine, const BitGrid& soup, const BenchConfig& config, EngineReport& report) {
+#if defined(_WIN32)
+    // No fork: run in this process and leave peak RSS unmeasured
+    report.result = runEngine(engine, soup, config);
+    return true;
+#else
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        EngineResult result = runEngine(engine, soup, config);
+        ssize_t written = write(fds[1], &result, sizeof(result));
+        close(fds[1]);
+        _exit(written == static_cast<ssize_t>(sizeof(result)) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    size_t received = 0;
+    char* buffer = reinterpret_cast<char*>(&report.result);
+    while (received < sizeof(report.result)) {
+        ssize_t n = read(fds[0], buffer + received, sizeof(report.result) - received);
+        if (n <= 0) break;
+        received += static_cast<size_t>(n);
+    }
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) < 0) {
+        return false;
+    }
+#if defined(__APPLE__)
+    report.peakRssKb = usage.ru_maxrss / 1024;  // Reported in bytes on macOS
+#else
+    report.peakRssKb = usage.ru_maxrss;
+#endif
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 && received == sizeof(report.result);
+#endif
+}
+
+bool isTorusEngine(const string& engine) {
+    return engine != "sparse";
+}
+
+string toHex(uint64_t value) {
+    char text[19];
+    snprintf(text, sizeof(text), "0x%016llx", static_cast<unsigned long long>(value));
+    return text;
+}
+
+void printJson(const BenchConfig& config, const vector<EngineReport>& reports) {
+    double cellUpdates = static_cast<double>(config.rows) * config.cols * config.generations;
+
+    // Every torus engine must land on the same final state
+    bool checksumsMatch = true;
+    const EngineReport* first = nullptr;
+    for (const EngineReport& report : reports) {
+        if (!report.result.ran || !isTorusEngine(report.engine)) continue;
+        if (first && report.result.checksum != first->result.checksum) {
+            checksumsMatch = false;
+        }
+        if (!first) first = &report;
+    }
+
+    cout << "{\n";
+    cout << "  \"benchmark\": \"life\",\n";
+    cout << "  \"rows\": " << config.rows << ",\n";
+    cout << "  \"cols\": " << config.cols << ",\n";
+    cout << "  \"density\": " << config.density << ",\n";
+    cout << "  \"seed\": " << config.seed << ",\n";
+    cout << "  \"generations\": " << config.generations << ",\n";
+    int threads = config.threads > 0 ? config.threads : static_cast<int>(thread::hardware_concurrency());
+    cout << "  \"threads\": " << (threads > 0 ? threads : 1) << ",\n";
+    cout << "  \"simd\": \"" << life::simdLevelName(life::activeSimdLevel()) << "\",\n";
+    cout << "  \"results\": [\n";
+    for (size_t i = 0; i < reports.size(); i++) {
+        const EngineReport& report = reports[i];
+        cout << "    {\"engine\": \"" << report.engine << "\", "
+             << "\"topology\": \"" << (isTorusEngine(report.engine) ? "torus" : "plane") << "\", ";
+        if (report.result.ran) {
+            double rate = report.result.wallSeconds > 0 ? cellUpdates / report.result.wallSeconds : 0;
+            cout << "\"wall_seconds\": " << report.result.wallSeconds << ", "
+                 << "\"cell_updates_per_second\": " << rate << ", "
+                 << "\"peak_rss_kb\": " << (report.peakRssKb >= 0 ? to_string(report.peakRssKb) : "null") << ", "
+                 << "\"population\": " << report.result.population << ", "
+                 << "\"checksum\": \"" << toHex(report.result.checksum) << "\"}";
+        } else {
+            cout << "\"skipped\": \"" << report.result.skipReason << "\"}";
+        }
+        cout << (i + 1 < reports.size() ? ",\n" : "\n");
+    }
+    cout << "  ],\n";
+    cout << "  \"checksums_match\": " << (checksumsMatch ? "true" : "false") << "\n";
+    cout << "}\n";
+}
+
+void printSummary(const BenchConfig& config, const vector<EngineReport>& reports) {
+    double cellUpdates = static_cast<double>(config.rows) * config.cols * config.generations;
+    cerr << "Life benchmark: " << config.rows << "x" << config.cols << ", density " << config.density
+         << ", seed " << config.seed << ", " << config.generations << " generations\n";
+    for (const EngineReport& report : reports) {
+        char line[160];
+        if (report.result.ran) {
+            double rate = report.result.wallSeconds > 0 ? cellUpdates / report.result.wallSeconds : 0;
+            string rss = report.peakRssKb >= 0 ? to_string(report.peakRssKb) + " KB" : "n/a";
+            snprintf(line, sizeof(line), "  %-13s %10.4f s %12.3f Gcell/s %12s  %s\n",
+                     report.engine.c_str(), report.result.wallSeconds, rate / 1e9, rss.c_str(),
+                     toHex(report.result.checksum).c_str());
+        } else {
+            snprintf(line, sizeof(line), "  %-13s skipped (%s)\n", report.engine.c_str(), report.result.skipReason);
+        }
+        cerr << line;
+    }
+}
@@ -11,7 +11,11 @@
 #include <fstream>
 #include <string>
 #include <limits>
-#include <map>
+#include "../Life_Engine/simd_kernels.hpp"
+#include "../Life_Engine/parallel_step.hpp"
+#include "../Life_Engine/census.hpp"
+#include "../Life_Engine/win_conditions.hpp"
+#include "../../Terminal_Renderer/terminal_renderer.hpp"
 using namespace std;
 
 // Game configuration constants
@@ -19,12 +23,22 @@ const int DEFAULT_ROWS = 20;
 const int DEFAULT_COLS = 40;
 const int MAX_GENERATIONS = 1000;
 const int DISPLAY_DELAY_MS = 500;
+const int POPULATION_WINDOW = 100;  // Generations of population history kept for the summary
 
-// Win condition tracking
-struct WinCondition {
-    bool achieved = false;
-    int generation = 0;
-    string description;
+// Every win condition, in the order the summary lists them
+enum WinConditionId {
+    STABILITY,
+    SURVIVAL_10,
+    SURVIVAL_25,
+    SURVIVAL_50,
+    SURVIVAL_100,
+    POPULATION_BALANCE,
+    GLIDER_PATTERN,
+    BLINKER_PATTERN,
+    BLOCK_PATTERN,
+    TIME_ATTACK_100,
+    TIME_ATTACK_500,
+    WIN_CONDITION_COUNT
 };
 
 struct GameStats {
@@ -32,50 +46,70 @@ struct GameStats {
     int liveCells = 0;
     int maxLiveCells = 0;
     int minLiveCells = 0;
-    int stabilityCount = 0;
-    int populationInRangeCount = 0;
-    bool hasOscillated = false;
-    vector<int> populationHistory;
+    SlidingWindow populationHistory{POPULATION_WINDOW};
+    vector<life::CensusEntry> census;  // Objects on the board, most frequent first
     
-    // Win conditions
-    map<string, WinCondition> winConditions;
+    // Win conditions, registered once and fed one GenerationDelta per generation
+    ConditionEngine winConditions;
     
     GameStats() {
-        // Initialize all possible win conditions
-        winConditions["stability"] = {false, 0, "Stability Goal - Reached a stable configuration"};
-        winConditions["survival_10"] = {false, 0, "Survival Goal - Kept cells alive for 10 generations"};
-        winConditions["survival_25"] = {false, 0, "Survival Goal - Kept cells alive for 25 generations"};
-        winConditions["survival_50"] = {false, 0, "Survival Goal - Kept cells alive for 50 generations"};
-        winConditions["survival_100"] = {false, 0, "Survival Goal - Kept cells alive for 100 generations"};
-        winConditions["population_balance"] = {false, 0, "Population Target - Maintained balanced population (20-30) for 20 generations"};
-        winConditions["glider_pattern"] = {false, 0, "Pattern Creation - Created a glider pattern"};
-        winConditions["blinker_pattern"] = {false, 0, "Pattern Creation - Created a blinker pattern"};
-        winConditions["block_pattern"] = {false, 0, "Pattern Creation - Created a block pattern"};
-        winConditions["time_attack_100"] = {false, 0, "Time Attack - Survived 100+ generations"};
-        winConditions["time_attack_500"] = {false, 0, "Time Attack - Survived 500+ generations"};
+        winConditions.addStillGoal(STABILITY, "Stability Goal - Reached a stable configuration", 3);
+        winConditions.addGenerationGoal(SURVIVAL_10, "Survival Goal - Kept cells alive for 10 generations", 10);
+        winConditions.addGenerationGoal(SURVIVAL_25, "Survival Goal - Kept cells alive for 25 generations", 25);
+        winConditions.addGenerationGoal(SURVIVAL_50, "Survival Goal - Kept cells alive for 50 generations", 50);
+        winConditions.addGenerationGoal(SURVIVAL_100, "Survival Goal - Kept cells alive for 100 generations", 100);
+        winConditions.addPopulationGoal(POPULATION_BALANCE, "Population Target - Maintained balanced population (20-30) for 20 generations", 20, 30, 20);
+        winConditions.addEventGoal(GLIDER_PATTERN, "Pattern Creation - Created a glider pattern");
+        winConditions.addEventGoal(BLINKER_PATTERN, "Pattern Creation - Created a blinker pattern");
+        winConditions.addEventGoal(BLOCK_PATTERN, "Pattern Creation - Created a block pattern");
+        winConditions.addGenerationGoal(TIME_ATTACK_100, "Time Attack - Survived 100+ generations", 100);
+        winConditions.addGenerationGoal(TIME_ATTACK_500, "Time Attack - Survived 500+ generations", 500);
     }
 };
 
 // Function declarations
 void initializeGrid(vector<vector<bool>>& grid, int rows, int cols);
-void displayGrid(const vector<vector<bool>>& grid, const GameStats& stats);
+void displayGrid(const vector<vector<bool>>& grid, const GameStats& stats, bool incremental = false);
 void randomFill(vector<vector<bool>>& grid, double density = 0.3);
 void manualSetup(vector<vector<bool>>& grid);
-int countLiveNeighbors(const vector<vector<bool>>& grid, int row, int col, int rows, int cols);
-void evolveGrid(vector<vector<bool>>& grid, vector<vector<bool>>& nextGrid, int rows, int cols);
+life::GenerationDelta evolveGrid(vector<vector<bool>>& grid, vector<vector<bool>>& nextGrid, int rows, int cols, BitGrid& packed);
 void saveGrid(const vector<vector<bool>>& grid, const string& filename);
 bool loadGrid(vector<vector<bool>>& grid, const string& filename);
 int countLiveCells(const vector<vector<bool>>& grid);
-bool isStable(const vector<vector<bool>>& current, const vector<vector<bool>>& previous);
-bool detectPatterns(const vector<vector<bool>>& grid, GameStats& stats);
-void updateGameStats(vector<vector<bool>>& grid, vector<vector<bool>>& previousGrid, GameStats& stats);
-void checkWinConditions(GameStats& stats);
+BitGrid packGrid(const vector<vector<bool>>& grid);
+bool detectPatterns(const BitGrid& packed, GameStats& stats);
+void updateGameStats(const life::GenerationDelta& delta, const BitGrid& packed, GameStats& stats);
 void showWinSummary(const GameStats& stats);
 void runAutoDetectSimulation(vector<vector<bool>>& grid, int rows, int cols);
 void showMenu();
+ThreadPool& workerPool();
+life::Rule& activeRule();
+life::PatternCensus& patternCensus();
 
-int main() {
-    cout << "=== Conway's Game of Life - Auto-Detect Mode ===\n\n";
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        // Verify every SIMD kernel against the per-cell reference and exit
+        if (arg == "--self-check") {
+            cout << "Running generation kernel self-check...\n";
+            bool passed = life::runKernelSelfCheck(cout);
+            cout << (passed ? "All kernels match.\n" : "Kernel self-check FAILED.\n");
+            return passed ? 0 : 1;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            workerPool().setThreadCount(atoi(argv[++i]));
+        } else if (arg == "--rule" && i + 1 < argc) {
+            string error;
+            if (!life::parseRule(argv[++i], activeRule(), error)) {
+                cout << "Invalid rule: " << error << "\n";
+                return 1;
+            }
+        }
+    }
+    
+    cout << "=== Conway's Game of Life - Auto-Detect Mode ===\n";
+    cout << "Generation kernel: " << life::simdLevelName(life::activeSimdLevel())
+         << " | Threads: " << workerPool().getThreadCount()
+         << " | Rule: " << life::ruleName(activeRule()) << "\n\n";
     
     int rows, cols;
     cout << "Enter grid dimensions (rows columns): ";
@@ -148,12 +182,14 @@ int main() {
 
 void runAutoDetectSimulation(vector<vector<bool>>& grid, int rows, int cols) {
     vector<vector<bool>> nextGrid(rows, vector<bool>(cols, false));
-    vector<vector<bool>> previousGrid(rows, vector<bool>(cols, false));
+    BitGrid packed = packGrid(grid);  // The current generation, as the kernel and census see it
     
     GameStats stats;
     stats.liveCells = countLiveCells(grid);
     stats.maxLiveCells = stats.liveCells;
     stats.minLiveCells = stats.liveCells;
+    stats.populationHistory.push(stats.liveCells);
+    life::GenerationDelta delta = {0, stats.liveCells, -1, life::hashGrid(packed)};
     
     cout << "Starting Auto-Detect Simulation...\n";
     cout << "The game will automatically detect when you achieve any win condition!\n\n";
@@ -164,8 +200,9 @@ void runAutoDetectSimulation(vector<vector<bool>>& grid, int rows, int cols) {
     
     bool gameEnded = false;
     
-    while (stats.generation < MAX_GENERATIONS && !gameEnded) {
-        displayGrid(grid, stats);
+    while (true) {
+        // Auto-run frames after the first only redraw what changed
+        displayGrid(grid, stats, autoRun && stats.generation > 0);
         
         // Check for game end conditions
         if (stats.liveCells == 0) {
@@ -174,40 +211,25 @@ void runAutoDetectSimulation(vector<vector<bool>>& grid, int rows, int cols) {
             break;
         }
         
-        // Update game statistics
-        updateGameStats(grid, previousGrid, stats);
-        
-        // Check for win conditions
-        checkWinConditions(stats);
-        
-        // Check if any win condition was achieved
-        bool anyWin = false;
-        for (const auto& win : stats.winConditions) {
-            if (win.second.achieved) {
-                anyWin = true;
-                break;
-            }
-        }
-        
-        if (anyWin) {
+        // Feed this generation to the win conditions
+        updateGameStats(delta, packed, stats);
+        if (stats.winConditions.getAchievedCount() > 0) {
             showWinSummary(stats);
             gameEnded = true;
             break;
         }
         
-        // Store current state for stability check
-        previousGrid = grid;
+        // The last generation is shown and checked like every other one
+        if (stats.generation >= MAX_GENERATIONS) {
+            break;
+        }
         
         // Evolve to next generation
-        evolveGrid(grid, nextGrid, rows, cols);
+        delta = evolveGrid(grid, nextGrid, rows, cols, packed);
         stats.generation++;
-        stats.liveCells = countLiveCells(grid);
-        
-        // Update population history
-        stats.populationHistory.push_back(stats.liveCells);
-        if (stats.populationHistory.size() > 100) {
-            stats.populationHistory.erase(stats.populationHistory.begin());
-        }
+        delta.generation = stats.generation;
+        stats.liveCells = delta.population;
+        stats.populationHistory.push(stats.liveCells);
         
         if (!autoRun) {
             cout << "Press Enter for next generation, 'q' to quit: ";
@@ -229,7 +251,9 @@ void runAutoDetectSimulation(vector<vector<bool>>& grid, int rows, int cols) {
     cin.get();
 }
 
-void updateGameStats(vector<vector<bool>>& grid, vector<vector<bool>>& previousGrid, GameStats& stats) {
+// Everything is derived from what the kernel reported about the generation;
+// the grid itself is only read again by the census, and only when it changed
+void updateGameStats(const life::GenerationDelta& delta, const BitGrid& packed, GameStats& stats) {
     // Update max/min live cells
     if (stats.liveCells > stats.maxLiveCells) {
         stats.maxLiveCells = stats.liveCells;
@@ -238,133 +262,52 @@ void updateGameStats(vector<vector<bool>>& grid, vector<vector<bool>>& previousG
         stats.minLiveCells = stats.liveCells;
     }
     
-    // Check for stability
-    if (stats.generation > 0 && isStable(grid, previousGrid)) {
-        stats.stabilityCount++;
-    } else {
-        stats.stabilityCount = 0;
-    }
-    
-    // Check for population in target range
-    if (stats.liveCells >= 20 && stats.liveCells <= 30) {
-        stats.populationInRangeCount++;
-    } else {
-        stats.populationInRangeCount = 0;
-    }
-    
-    // Detect patterns
-    detectPatterns(grid, stats);
-}
-
-void checkWinConditions(GameStats& stats) {
-    // Stability Goal
-    if (stats.stabilityCount >= 3 && !stats.winConditions["stability"].achieved) {
-        stats.winConditions["stability"].achieved = true;
-        stats.winConditions["stability"].generation = stats.generation;
-    }
-    
-    // Survival Goals
-    if (stats.generation >= 10 && !stats.winConditions["survival_10"].achieved) {
-        stats.winConditions["survival_10"].achieved = true;
-        stats.winConditions["survival_10"].generation = stats.generation;
-    }
-    if (stats.generation >= 25 && !stats.winConditions["survival_25"].achieved) {
-        stats.winConditions["survival_25"].achieved = true;
-        stats.winConditions["survival_25"].generation = stats.generation;
-    }
-    if (stats.generation >= 50 && !stats.winConditions["survival_50"].achieved) {
-        stats.winConditions["survival_50"].achieved = true;
-        stats.winConditions["survival_50"].generation = stats.generation;
-    }
-    if (stats.generation >= 100 && !stats.winConditions["survival_100"].achieved) {
-        stats.winConditions["survival_100"].achieved = true;
-        stats.winConditions["survival_100"].generation = stats.generation;
-    }
-    
-    // Population Target
-    if (stats.populationInRangeCount >= 20 && !stats.winConditions["population_balance"].achieved) {
-        stats.winConditions["population_balance"].achieved = true;
-        stats.winConditions["population_balance"].generation = stats.generation;
-    }
+    // Stability, survival, population and time attack goals
+    stats.winConditions.update(delta);
     
-    // Time Attack
-    if (stats.generation >= 100 && !stats.winConditions["time_attack_100"].achieved) {
-        stats.winConditions["time_attack_100"].achieved = true; 
-        stats.winConditions["time_attack_100"].generation = stats.generation;
-    }
-    if (stats.generation >= 500 && !stats.winConditions["time_attack_500"].achieved) {
-        stats.winConditions["time_attack_500"].achieved = true;
-        stats.winConditions["time_attack_500"].generation = stats.generation;
+    // Pattern goals; an unchanged board holds the objects it held last time
+    if (delta.changedCells != 0) {
+        detectPatterns(packed, stats);
     }
 }
 
-bool detectPatterns(const vector<vector<bool>>& grid, GameStats& stats) {
-    int rows = grid.size();
-    int cols = grid[0].size();
-    
-    // Check for glider pattern (simplified detection)
-    for (int i = 0; i < rows - 2; i++) {
-        for (int j = 0; j < cols - 2; j++) {
-            // Simple glider detection (5 cells in specific pattern)
-            int liveCount = 0;
-            if (grid[i][j+1]) liveCount++;
-            if (grid[i+1][j+2]) liveCount++;
-            if (grid[i+2][j]) liveCount++;
-            if (grid[i+2][j+1]) liveCount++;
-            if (grid[i+2][j+2]) liveCount++;
-            
-            if (liveCount == 5 && !stats.winConditions["glider_pattern"].achieved) {
-                stats.winConditions["glider_pattern"].achieved = true;
-                stats.winConditions["glider_pattern"].generation = stats.generation;
-                return true;
-            }
-        }
-    }
-    
-    // Check for blinker pattern (3 cells in a row or column)
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols - 2; j++) {
-            if (grid[i][j] && grid[i][j+1] && grid[i][j+2] && 
-                !grid[i][j-1] && !grid[i][j+3]) {
-                if (!stats.winConditions["blinker_pattern"].achieved) {
-                    stats.winConditions["blinker_pattern"].achieved = true;
-                    stats.winConditions["blinker_pattern"].generation = stats.generation;
-                    return true;
-                }
-            }
+bool detectPatterns(const BitGrid& packed, GameStats& stats) {
+    // One census pass names every object on the board in any orientation
+    stats.census = patternCensus().take(packed);
+    
+    bool newPattern = false;
+    for (const auto& entry : stats.census) {
+        WinConditionId id;
+        if (entry.name == "glider") {
+            id = GLIDER_PATTERN;
+        } else if (entry.name == "blinker") {
+            id = BLINKER_PATTERN;
+        } else if (entry.name == "block") {
+            id = BLOCK_PATTERN;
+        } else {
+            continue;
         }
-    }
-    
-    // Check for block pattern (2x2 square)
-    for (int i = 0; i < rows - 1; i++) {
-        for (int j = 0; j < cols - 1; j++) {
-            if (grid[i][j] && grid[i][j+1] && grid[i+1][j] && grid[i+1][j+1]) {
-                if (!stats.winConditions["block_pattern"].achieved) {
-                    stats.winConditions["block_pattern"].achieved = true;
-                    stats.winConditions["block_pattern"].generation = stats.generation;
-                    return true;
-                }
-            }
+        if (!stats.winConditions.isAchieved(id)) {
+            stats.winConditions.achieve(id, stats.generation);
+            newPattern = true;
         }
     }
     
-    return false;
+    return newPattern;
 }
 
 void showWinSummary(const GameStats& stats) {
     cout << "\n🎉 WIN CONDITION SUMMARY 🎉\n";
     cout << "=============================\n";
     
-    bool anyWin = false;
-    for (const auto& win : stats.winConditions) {
-        if (win.second.achieved) {
-            cout << "✅ " << win.second.description;
-            cout << " (Generation " << win.second.generation << ")\n";
-            anyWin = true;
+    for (int id = 0; id < WIN_CONDITION_COUNT; id++) {
+        if (stats.winConditions.isAchieved(id)) {
+            cout << "✅ " << stats.winConditions.getDescription(id);
+            cout << " (Generation " << stats.winConditions.getAchievedGeneration(id) << ")\n";
         }
     }
     
-    if (!anyWin) {
+    if (stats.winConditions.getAchievedCount() == 0) {
         cout << "No win conditions achieved yet.\n";
     }
     
@@ -373,6 +316,23 @@ void showWinSummary(const GameStats& stats) {
     cout << "Final Live Cells: " << stats.liveCells << "\n";
     cout << "Max Live Cells: " << stats.maxLiveCells << "\n";
     cout << "Min Live Cells: " << stats.minLiveCells << "\n";
+    if (!stats.populationHistory.empty()) {
+        cout << "Last " << stats.populationHistory.size() << " Generations: min " << stats.populationHistory.min()
+             << ", mean " << static_cast<int>(stats.populationHistory.mean() + 0.5)
+             << ", max " << stats.populationHistory.max() << " live cells\n";
+    }
+    if (!stats.census.empty()) {
+        cout << "Objects on the board:\n";
+        for (const auto& entry : stats.census) {
+            cout << "  " << entry.count << " x " << entry.name;
+            if (entry.kind != life::ObjectKind::UNKNOWN) {
+                cout << " (" << life::objectKindName(entry.kind);
+                if (entry.period > 1) cout << ", period " << entry.period;
+                cout << ")";
+            }
+            cout << "\n";
+        }
+    }
     cout << "=============================\n";
 }
 
@@ -381,40 +341,56 @@ void initializeGrid(vector<vector<bool>>& grid, int rows, int cols) {
     cout << "Grid initialized with " << rows << "x" << cols << " dimensions.\n";
 }
 
-void displayGrid(const vector<vector<bool>>& grid, const GameStats& stats) {
-    system("cls"); // Clear screen (Windows)
+// Shared by every frame so each one only redraws what changed
+TerminalRenderer& terminal() {
+    static TerminalRenderer renderer;
+    return renderer;
+}
+
+void displayGrid(const vector<vector<bool>>& grid, const GameStats& stats, bool incremental) {
+    TerminalRenderer& screen = terminal();
+    if (!incremental) {
+        screen.invalidate(); // Prompts may have scrolled the screen
+    }
+    screen.beginFrame();
     
-    cout << "=== Conway's Game of Life - Auto-Detect Mode ===\n";
-    cout << "Generation: " << stats.generation << " | Live Cells: " << stats.liveCells << "\n";
-    cout << "Max/Min Population: " << stats.maxLiveCells << "/" << stats.minLiveCells << "\n";
+    int rows = static_cast<int>(grid.size());
+    int cols = static_cast<int>(grid[0].size());
+    Viewport view = screen.fit(rows, cols, 2, 3, 5, 1);
+    
+    screen.line("=== Conway's Game of Life - Auto-Detect Mode ===");
+    string header = "Generation: " + to_string(stats.generation) + " | Live Cells: " + to_string(stats.liveCells);
+    if (view.clipped) {
+        header += " | " + view.label();
+    }
+    screen.line(header);
+    screen.line("Max/Min Population: " + to_string(stats.maxLiveCells) + "/" + to_string(stats.minLiveCells));
     
     // Show active win conditions
-    cout << "Active Win Conditions: ";
-    bool anyActive = false;
-    for (const auto& win : stats.winConditions) {
-        if (win.second.achieved) {
-            cout << "✅ ";
-            anyActive = true;
-        }
+    string active = "Active Win Conditions: ";
+    for (int i = 0; i < stats.winConditions.getAchievedCount(); i++) {
+        active += "✅ ";
     }
-    if (!anyActive) cout << "None yet";
-    cout << "\n\n";
+    if (stats.winConditions.getAchievedCount() == 0) active += "None yet";
+    screen.line(active);
+    screen.line("");
     
     // Print column numbers
-    cout << "   ";
-    for (int j = 0; j < grid[0].size(); j++) {
-        cout << (j % 10) << " ";
+    string line = "   ";
+    for (int j = view.firstCol; j < view.firstCol + view.cols; j++) {
+        line += to_string(j % 10) + " ";
     }
-    cout << "\n";
+    screen.line(line);
     
-    for (int i = 0; i < grid.size(); i++) {
-        cout << (i < 10 ? " " : "") << i << " ";
-        for (int j = 0; j < grid[i].size(); j++) {
-            cout << (grid[i][j] ? "■ " : ". ");
+    for (int i = view.firstRow; i < view.firstRow + view.rows; i++) {
+        line = (i < 10 ? " " : "") + to_string(i) + " ";
+        for (int j = view.firstCol; j < view.firstCol + view.cols; j++) {
+            line += grid[i][j] ? "■ " : ". ";
         }
-        cout << "\n";
+        screen.line(line);
     }
-    cout << "\n";
+    screen.line("");
+    screen.present();
 }
 
 void randomFill(vector<vector<bool>>& grid, double density) {
@@ -463,43 +439,62 @@ void manualSetup(vector<vector<bool>>& grid) {
     cout << "Manual setup complete. " << count << " cells set to alive.\n";
 }
 
-int countLiveNeighbors(const vector<vector<bool>>& grid, int row, int col, int rows, int cols) {
-    int count = 0;
-    
-    for (int i = -1; i <= 1; i++) {
-        for (int j = -1; j <= 1; j++) {
-            if (i == 0 && j == 0) continue; // Skip the cell itself
-            
-            int neighborRow = (row + i + rows) % rows; // Periodic boundary conditions
-            int neighborCol = (col + j + cols) % cols;
-            
-            if (grid[neighborRow][neighborCol]) {
-                count++;
-            }
-        }
-    }
-    
-    return count;
+// Rule every generation is computed with (B3/S23 unless --rule is given)
+life::Rule& activeRule() {
+    static life::Rule rule = life::CONWAY;
+    return rule;
+}
+
+// Worker threads shared by every generation (one per core unless --threads is given)
+ThreadPool& workerPool() {
+    static ThreadPool pool;
+    return pool;
 }
 
-void evolveGrid(vector<vector<bool>>& grid, vector<vector<bool>>& nextGrid, int rows, int cols) {
-    // Synchronous update - all cells updated simultaneously
+// Library of known objects, built on first use
+life::PatternCensus& patternCensus() {
+    static life::PatternCensus census;
+    return census;
+}
+
+// Synchronous update - packed holds the grid 64 cells per word, and the
+// widest SIMD kernel the CPU supports computes every cell simultaneously, with
+// large boards split into bands across the worker pool. The population, the
+// cells that changed and the hash come from the packed words on the way out.
+life::GenerationDelta evolveGrid(vector<vector<bool>>& grid, vector<vector<bool>>& nextGrid, int rows, int cols,
+                                 BitGrid& packed) {
+    BitGrid packedNext(rows, cols);
+    life::stepParallel(packed, packedNext, workerPool(), life::fastRuleKernel(activeRule()));
+    
+    life::GenerationDelta delta = {0, 0, 0, 0};
+    const uint64_t* before = packed.data();
+    const uint64_t* after = packedNext.data();
+    for (size_t w = 0; w < packedNext.wordCount(); w++) {
+        delta.population += __builtin_popcountll(after[w]);
+        delta.changedCells += __builtin_popcountll(before[w] ^ after[w]);
+        delta.hash ^= life::hashWord(after[w], w);
+    }
+    
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < cols; j++) {
-            int neighbors = countLiveNeighbors(grid, i, j, rows, cols);
-            
-            if (grid[i][j]) {
-                // Live cell
-                nextGrid[i][j] = (neighbors == 2 || neighbors == 3);
-            } else {
-                // Dead cell
-                nextGrid[i][j] = (neighbors == 3);
-            }
+            nextGrid[i][j] = packedNext.get(i, j);
         }
     }
     
     // Copy next generation to current grid
     grid = nextGrid;
+    swap(packed, packedNext);
+    return delta;
+}
+
+BitGrid packGrid(const vector<vector<bool>>& grid) {
+    BitGrid packed(static_cast<int>(grid.size()), static_cast<int>(grid[0].size()));
+    for (int i = 0; i < packed.getRows(); i++) {
+        for (int j = 0; j < packed.getCols(); j++) {
+            packed.set(i, j, grid[i][j]);
+        }
+    }
+    return packed;
 }
 
 void saveGrid(const vector<vector<bool>>& grid, const string& filename) {
@@ -558,17 +553,6 @@ int countLiveCells(const vector<vector<bool>>& grid) {
     return count;
 }
 
-bool isStable(const vector<vector<bool>>& current, const vector<vector<bool>>& previous) {
-    for (int i = 0; i < current.size(); i++) {
-        for (int j = 0; j < current[i].size(); j++) {
-            if (current[i][j] != previous[i][j]) {
-                return false;
-            }
-        }
-    }
-    return true;
-}
-
 void showMenu() {
     cout << "\n=== Main Menu ===\n";
     cout << "1. Random fill grid\n";
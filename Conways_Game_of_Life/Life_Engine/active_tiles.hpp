@@ -0,0 +1,323 @@
+// Active-region stepping for the bit-packed Life grid
+//
+// The torus is divided into tiles of TILE_HEIGHT rows by one 64-cell word.
+// A tile's next state only depends on the tile and the one-cell ring around
+// it, so each tile records where it changed during the last step: anywhere,
+// on its edge rows, its edge columns or its corners. A neighbour then only
+// wakes a tile up when the change was on the side facing it.
+//
+// The caller keeps a ring of N generation buffers, so the destination passed
+// to step() still holds the generation N-1 before `current`. A tile needs no
+// work when that old content is already its next state, which happens when
+// - its neighbourhood did not change last step and the tile itself has been
+//   still for N-1 generations, or
+// - its neighbourhood matches the one N generations ago, i.e. everything
+//   around it oscillates with a period dividing N (with N = 2 this covers
+//   blinkers, the most common object in soup ash).
+// Skipped tiles are not written at all.
+//
+// The tracker also returns how the grid hash (life::hashGrid) changed, so a
+// caller can keep a rolling hash of every generation at the cost of the
+// changed tiles only.
+//
+// Contract: the destination grid passed to step() must hold the generation
+// ringDepth - 1 before `current`, i.e. the caller rotates buffers rather than
+// copying. Call invalidate() whenever the grid is modified outside of step().
+//
+// Skipping only relies on each cell depending on its 3x3 neighbourhood alone,
+// so it holds for any Life-like rule (setRule).
+
+#ifndef LIFE_ACTIVE_TILES_HPP
+#define LIFE_ACTIVE_TILES_HPP
+
+#include "simd_kernels.hpp"
+#include "parallel_step.hpp"
+#include <cstdint>
+#include <vector>
+
+class ActiveTileTracker {
+public:
+    static const int TILE_HEIGHT = 16;
+
+private:
+    // Where a tile changed over the interval being tracked
+    enum ChangeFlags : uint16_t {
+        CHANGED_ANY = 1 << 0,
+        CHANGED_TOP = 1 << 1,
+        CHANGED_BOTTOM = 1 << 2,
+        CHANGED_LEFT = 1 << 3,
+        CHANGED_RIGHT = 1 << 4,
+        CHANGED_TOP_LEFT = 1 << 5,
+        CHANGED_TOP_RIGHT = 1 << 6,
+        CHANGED_BOTTOM_LEFT = 1 << 7,
+        CHANGED_BOTTOM_RIGHT = 1 << 8,
+        CHANGED_EVERYWHERE = 0x1FF
+    };
+
+    // What step() does with a tile
+    enum TileAction : uint8_t {
+        TILE_COMPUTE,   // Recompute it
+        TILE_STILL,     // Skip: still, and the destination holds the same cells
+        TILE_PERIODIC   // Skip: the destination holds the state N generations ago
+    };
+
+    int rows;
+    int cols;
+    int tileRows;
+    int tileCols;
+    int ringDepth;
+    std::vector<uint16_t> changed1;  // ChangeFlags against the previous generation
+    std::vector<uint16_t> changedN;  // ChangeFlags against ringDepth generations ago
+    std::vector<uint8_t> stillFor;   // Generations the tile has gone unchanged (saturating)
+    std::vector<uint8_t> action;     // TileAction for this step
+    std::vector<uint64_t> rowHashDelta;                // Hash change per tile row
+    std::vector<std::vector<uint64_t>> savedByWorker;  // Destination words overwritten by a run
+    life::RuleKernel kernel;
+    bool fullStep;                   // Recompute everything on the next step
+    int stepsSinceInvalidate;
+    int activeTiles;
+    uint64_t hashDelta;
+
+    uint16_t flagsAt(const std::vector<uint16_t>& flags, int tileRow, int tileCol) const {
+        tileRow = (tileRow + tileRows) % tileRows;
+        tileCol = (tileCol + tileCols) % tileCols;
+        return flags[static_cast<size_t>(tileRow) * tileCols + tileCol];
+    }
+
+    // Whether anything in the tile or the one-cell ring around it changed
+    bool ringChanged(const std::vector<uint16_t>& flags, int tr, int tc) const {
+        return (flagsAt(flags, tr, tc) & CHANGED_ANY)
+            || (flagsAt(flags, tr - 1, tc) & CHANGED_BOTTOM)
+            || (flagsAt(flags, tr + 1, tc) & CHANGED_TOP)
+            || (flagsAt(flags, tr, tc - 1) & CHANGED_RIGHT)
+            || (flagsAt(flags, tr, tc + 1) & CHANGED_LEFT)
+            || (flagsAt(flags, tr - 1, tc - 1) & CHANGED_BOTTOM_RIGHT)
+            || (flagsAt(flags, tr - 1, tc + 1) & CHANGED_BOTTOM_LEFT)
+            || (flagsAt(flags, tr + 1, tc - 1) & CHANGED_TOP_RIGHT)
+            || (flagsAt(flags, tr + 1, tc + 1) & CHANGED_TOP_LEFT);
+    }
+
+    // Summarise the differing bits of one tile into ChangeFlags
+    static uint16_t flagsFor(uint64_t any, uint64_t top, uint64_t bottom, int rightBit) {
+        uint16_t flags = 0;
+        if (any) flags |= CHANGED_ANY;
+        if (top) flags |= CHANGED_TOP;
+        if (bottom) flags |= CHANGED_BOTTOM;
+        if (any & 1ULL) flags |= CHANGED_LEFT;
+        if ((any >> rightBit) & 1ULL) flags |= CHANGED_RIGHT;
+        if (top & 1ULL) flags |= CHANGED_TOP_LEFT;
+        if ((top >> rightBit) & 1ULL) flags |= CHANGED_TOP_RIGHT;
+        if (bottom & 1ULL) flags |= CHANGED_BOTTOM_LEFT;
+        if ((bottom >> rightBit) & 1ULL) flags |= CHANGED_BOTTOM_RIGHT;
+        return flags;
+    }
+
+    static uint8_t oneMore(uint8_t count) { return count == 255 ? count : count + 1; }
+
+    void resize(int r, int c) {
+        rows = r;
+        cols = c;
+        tileRows = (r + TILE_HEIGHT - 1) / TILE_HEIGHT;
+        tileCols = (c + 63) / 64;
+        changed1.assign(static_cast<size_t>(tileRows) * tileCols, CHANGED_EVERYWHERE);
+        changedN.assign(changed1.size(), CHANGED_EVERYWHERE);
+        stillFor.assign(changed1.size(), 0);
+        action.assign(changed1.size(), TILE_COMPUTE);
+        rowHashDelta.assign(tileRows, 0);
+        invalidate();
+    }
+
+    // Hash change of the words of tile (tr, t) between current and next
+    uint64_t tileHashDelta(const BitGrid& current, const BitGrid& next, int tr, int t) const {
+        uint64_t delta = 0;
+        int rowEnd = (tr + 1) * TILE_HEIGHT < rows ? (tr + 1) * TILE_HEIGHT : rows;
+        for (int r = tr * TILE_HEIGHT; r < rowEnd; r++) {
+            uint64_t before = current.row(r)[t];
+            uint64_t after = next.row(r)[t];
+            if (before != after) {
+                size_t index = static_cast<size_t>(r) * tileCols + t;
+                delta ^= life::hashWord(before, index) ^ life::hashWord(after, index);
+            }
+        }
+        return delta;
+    }
+
+    // Recompute each horizontal run of tiles in [tileBegin, tileEnd) that
+    // needs it with one kernel call, then record where every tile changed
+    void stepTileRows(const BitGrid& current, BitGrid& next, int tileBegin, int tileEnd,
+                      std::vector<uint64_t>& saved) {
+        int lastBit = (cols - 1) & 63;
+        // The destination only holds a real generation once the ring has been
+        // refilled since the last invalidate()
+        bool historyValid = stepsSinceInvalidate >= ringDepth - 1;
+
+        for (int tr = tileBegin; tr < tileEnd; tr++) {
+            int rowBegin = tr * TILE_HEIGHT;
+            int rowEnd = rowBegin + TILE_HEIGHT < rows ? rowBegin + TILE_HEIGHT : rows;
+            size_t tileBase = static_cast<size_t>(tr) * tileCols;
+            uint64_t delta = 0;
+
+            int tc = 0;
+            while (tc < tileCols) {
+                size_t tile = tileBase + tc;
+                if (action[tile] == TILE_STILL) {
+                    changed1[tile] = 0;
+                    changedN[tile] = 0;
+                    stillFor[tile] = oneMore(stillFor[tile]);
+                    tc++;
+                    continue;
+                }
+                if (action[tile] == TILE_PERIODIC) {
+                    // The tile now holds what it held ringDepth generations ago.
+                    // With a ring of two its change against the previous generation
+                    // is the same as last step's, just reversed; otherwise unknown.
+                    changedN[tile] = 0;
+                    if (ringDepth != 2) {
+                        changed1[tile] = CHANGED_EVERYWHERE;
+                    }
+                    if (changed1[tile] & CHANGED_ANY) {
+                        stillFor[tile] = 0;
+                        delta ^= tileHashDelta(current, next, tr, tc);
+                    } else {
+                        stillFor[tile] = oneMore(stillFor[tile]);
+                    }
+                    tc++;
+                    continue;
+                }
+
+                int runEnd = tc;
+                while (runEnd < tileCols && action[tileBase + runEnd] == TILE_COMPUTE) runEnd++;
+                int runWords = runEnd - tc;
+
+                // Keep the generation being overwritten to measure changes over the ring
+                if (historyValid) {
+                    saved.resize(static_cast<size_t>(rowEnd - rowBegin) * runWords);
+                    for (int r = rowBegin; r < rowEnd; r++) {
+                        for (int t = tc; t < runEnd; t++) {
+                            saved[static_cast<size_t>(r - rowBegin) * runWords + (t - tc)] = next.row(r)[t];
+                        }
+                    }
+                }
+
+                kernel(current, next, rowBegin, rowEnd, tc, runEnd);
+
+                for (int t = tc; t < runEnd; t++) {
+                    int rightBit = t == tileCols - 1 ? lastBit : 63;
+                    uint64_t any1 = 0, anyN = 0, top1 = 0, topN = 0, bottom1 = 0, bottomN = 0;
+                    for (int r = rowBegin; r < rowEnd; r++) {
+                        uint64_t before = current.row(r)[t];
+                        uint64_t after = next.row(r)[t];
+                        uint64_t diff1 = before ^ after;
+                        uint64_t diffN = historyValid
+                            ? saved[static_cast<size_t>(r - rowBegin) * runWords + (t - tc)] ^ after : 0;
+                        any1 |= diff1;
+                        anyN |= diffN;
+                        if (r == rowBegin) { top1 = diff1; topN = diffN; }
+                        if (r == rowEnd - 1) { bottom1 = diff1; bottomN = diffN; }
+                        if (diff1) {
+                            size_t index = static_cast<size_t>(r) * tileCols + t;
+                            delta ^= life::hashWord(before, index) ^ life::hashWord(after, index);
+                        }
+                    }
+
+                    size_t done = tileBase + t;
+                    changed1[done] = flagsFor(any1, top1, bottom1, rightBit);
+                    changedN[done] = historyValid ? flagsFor(anyN, topN, bottomN, rightBit)
+                                                  : static_cast<uint16_t>(CHANGED_EVERYWHERE);
+                    if (any1) {
+                        stillFor[done] = 0;
+                    } else {
+                        stillFor[done] = fullStep ? 1 : oneMore(stillFor[done]);
+                    }
+                }
+                tc = runEnd;
+            }
+            rowHashDelta[tr] = delta;
+        }
+    }
+
+public:
+    ActiveTileTracker(int r = 0, int c = 0)
+        : ringDepth(2), savedByWorker(1), kernel(life::fastRuleKernel(life::CONWAY)), activeTiles(0), hashDelta(0) {
+        resize(r, c);
+    }
+
+    // Rule the tiles are computed with (B3/S23 by default)
+    void setRule(const life::Rule& rule) {
+        kernel = life::fastRuleKernel(rule);
+        invalidate();
+    }
+
+    // Forget change history; the next step recomputes every tile
+    void invalidate() {
+        fullStep = true;
+        stepsSinceInvalidate = 0;
+    }
+
+    // Number of generation buffers the caller rotates through (at least 2)
+    void setRingDepth(int depth) {
+        ringDepth = depth < 2 ? 2 : depth;
+        invalidate();
+    }
+
+    int getRingDepth() const { return ringDepth; }
+    int getActiveTiles() const { return activeTiles; }
+    int getTileCount() const { return tileRows * tileCols; }
+
+    // life::hashGrid(next) ^ life::hashGrid(current) for the last step
+    uint64_t getHashDelta() const { return hashDelta; }
+
+    // Compute the generation after current into next (which holds the one
+    // ringDepth - 1 before current), returning the number of tiles recomputed.
+    // Tile rows are spread over the pool's threads when one is given.
+    int step(const BitGrid& current, BitGrid& next, ThreadPool* pool = nullptr) {
+        if (current.getRows() != rows || current.getCols() != cols) {
+            resize(current.getRows(), current.getCols());
+        }
+
+        activeTiles = 0;
+        for (int tr = 0; tr < tileRows; tr++) {
+            for (int tc = 0; tc < tileCols; tc++) {
+                size_t tile = static_cast<size_t>(tr) * tileCols + tc;
+                uint8_t chosen = TILE_COMPUTE;
+                if (!fullStep) {
+                    // stillFor only counts generations since invalidate(), so it
+                    // also guarantees the destination is a real generation
+                    if (stillFor[tile] >= ringDepth - 1 && !ringChanged(changed1, tr, tc)) {
+                        chosen = TILE_STILL;
+                    } else if (stepsSinceInvalidate >= ringDepth && !ringChanged(changedN, tr, tc)) {
+                        chosen = TILE_PERIODIC;
+                    }
+                }
+                action[tile] = chosen;
+                if (chosen == TILE_COMPUTE) activeTiles++;
+            }
+        }
+
+        // Tile rows are independent: each writes only its own rows of next
+        // and its own flags, reading flags from the scheduling pass above
+        if (pool == nullptr || current.wordCount() < life::PARALLEL_MIN_WORDS) {
+            stepTileRows(current, next, 0, tileRows, savedByWorker[0]);
+        } else {
+            if (static_cast<int>(savedByWorker.size()) < pool->getThreadCount()) {
+                savedByWorker.resize(pool->getThreadCount());
+            }
+            pool->parallelFor(tileRows, [&](int tr, int worker) {
+                stepTileRows(current, next, tr, tr + 1, savedByWorker[worker]);
+            });
+        }
+
+        hashDelta = 0;
+        for (int tr = 0; tr < tileRows; tr++) {
+            hashDelta ^= rowHashDelta[tr];
+        }
+
+        fullStep = false;
+        if (stepsSinceInvalidate < ringDepth) {
+            stepsSinceInvalidate++;
+        }
+        return activeTiles;
+    }
+};
+
+#endif // LIFE_ACTIVE_TILES_HPP
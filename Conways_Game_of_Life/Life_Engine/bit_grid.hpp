@@ -0,0 +1,202 @@
+// Bit-packed storage and word-parallel generation kernel for Conway's Game of Life
+// Shared by the console and OOP versions of the game.
+//
+// Cells are stored 64 per 64-bit word. Each row is padded to a whole number of
+// words; bit j of word w in a row holds column (w * 64 + j). Padding bits past
+// the last column are always kept at zero.
+
+#ifndef LIFE_BIT_GRID_HPP
+#define LIFE_BIT_GRID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class BitGrid {
+private:
+    int rows;
+    int cols;
+    int wordsPerRow;
+    std::vector<uint64_t> words;
+
+public:
+    BitGrid(int r = 0, int c = 0)
+        : rows(r), cols(c), wordsPerRow((c + 63) / 64), words(static_cast<std::size_t>(r) * ((c + 63) / 64), 0) {}
+
+    // Getters
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getWordsPerRow() const { return wordsPerRow; }
+
+    // Mask of the valid bits in the last word of each row
+    uint64_t lastWordMask() const {
+        int tail = cols % 64;
+        return tail == 0 ? ~0ULL : ((1ULL << tail) - 1);
+    }
+
+    uint64_t* row(int r) { return words.data() + static_cast<std::size_t>(r) * wordsPerRow; }
+    const uint64_t* row(int r) const { return words.data() + static_cast<std::size_t>(r) * wordsPerRow; }
+    uint64_t* data() { return words.data(); }
+    const uint64_t* data() const { return words.data(); }
+    std::size_t wordCount() const { return words.size(); }
+
+    bool get(int r, int c) const {
+        return (row(r)[c >> 6] >> (c & 63)) & 1ULL;
+    }
+
+    void set(int r, int c, bool alive) {
+        uint64_t bit = 1ULL << (c & 63);
+        if (alive) {
+            row(r)[c >> 6] |= bit;
+        } else {
+            row(r)[c >> 6] &= ~bit;
+        }
+    }
+
+    void clear() {
+        words.assign(words.size(), 0);
+    }
+
+    int popcount() const {
+        int count = 0;
+        for (uint64_t w : words) {
+            count += __builtin_popcountll(w);
+        }
+        return count;
+    }
+
+    bool operator==(const BitGrid& other) const {
+        return rows == other.rows && cols == other.cols && words == other.words;
+    }
+    bool operator!=(const BitGrid& other) const { return !(*this == other); }
+};
+
+// Force the adder tree inline so SIMD callers compile it for their own instruction set
+#if defined(__GNUC__)
+#define LIFE_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define LIFE_ALWAYS_INLINE inline
+#endif
+
+namespace life {
+
+// Add three one-bit lanes; each bit position is an independent adder.
+// Lanes is uint64_t for the portable kernel or a SIMD vector of words, which
+// is why everything is passed by reference rather than through vector registers.
+template <typename Lanes>
+LIFE_ALWAYS_INLINE void fullAdd(const Lanes& a, const Lanes& b, const Lanes& c, Lanes& sum, Lanes& carry) {
+    Lanes t = a ^ b;
+    sum = t ^ c;
+    carry = (a & b) | (t & c);
+}
+
+template <typename Lanes>
+LIFE_ALWAYS_INLINE void halfAdd(const Lanes& a, const Lanes& b, Lanes& sum, Lanes& carry) {
+    sum = a ^ b;
+    carry = a & b;
+}
+
+// Next state of 64 cells per lane at once. a/b/c are the rows above, at and
+// below the cells; the W/E variants are the same rows shifted so that each bit
+// lines up with its west/east neighbour. The eight neighbour bits are summed
+// into a 4-bit count (s8 s4 s2 s1) with a full-adder tree, then B3/S23 is applied.
+template <typename Lanes>
+LIFE_ALWAYS_INLINE void conwayLanes(const Lanes& aW, const Lanes& a, const Lanes& aE,
+                                    const Lanes& bW, const Lanes& b, const Lanes& bE,
+                                    const Lanes& cW, const Lanes& c, const Lanes& cE, Lanes& next) {
+    Lanes top1, top2, bot1, bot2, mid1, mid2;
+    fullAdd(aW, a, aE, top1, top2);
+    fullAdd(cW, c, cE, bot1, bot2);
+    halfAdd(bW, bE, mid1, mid2);
+
+    Lanes s1, carry2;
+    fullAdd(top1, bot1, mid1, s1, carry2);
+
+    Lanes x2, x4, s2, y4, s4, s8;
+    fullAdd(top2, bot2, mid2, x2, x4);
+    halfAdd(x2, carry2, s2, y4);
+    halfAdd(x4, y4, s4, s8);
+
+    // Alive next if count == 3, or count == 2 and alive now
+    next = s2 & ~s4 & ~s8 & (s1 | b);
+}
+
+inline uint64_t conwayWord(uint64_t aW, uint64_t a, uint64_t aE,
+                           uint64_t bW, uint64_t b, uint64_t bE,
+                           uint64_t cW, uint64_t c, uint64_t cE) {
+    uint64_t next;
+    conwayLanes<uint64_t>(aW, a, aE, bW, b, bE, cW, c, cE, next);
+    return next;
+}
+
+// Row shifted so each bit holds its west neighbour (column - 1), wrapping at the torus edge
+inline uint64_t westOf(const uint64_t* row, int w, const BitGrid& grid) {
+    if (w > 0) {
+        return (row[w] << 1) | (row[w - 1] >> 63);
+    }
+    int last = grid.getCols() - 1;
+    return (row[0] << 1) | ((row[last >> 6] >> (last & 63)) & 1ULL);
+}
+
+// Row shifted so each bit holds its east neighbour (column + 1), wrapping at the torus edge.
+// Column 0 is pulled in directly above the last valid column of the final word.
+inline uint64_t eastOf(const uint64_t* row, int w, const BitGrid& grid) {
+    if (w < grid.getWordsPerRow() - 1) {
+        return (row[w] >> 1) | (row[w + 1] << 63);
+    }
+    int lastBit = (grid.getCols() - 1) & 63;
+    return (row[w] >> 1) | ((row[0] & 1ULL) << lastBit);
+}
+
+// Next state of word w of a row, given the source rows above, at and below it
+inline uint64_t stepWord(const BitGrid& grid, const uint64_t* above, const uint64_t* here,
+                         const uint64_t* below, int w) {
+    return conwayWord(westOf(above, w, grid), above[w], eastOf(above, w, grid),
+                      westOf(here, w, grid), here[w], eastOf(here, w, grid),
+                      westOf(below, w, grid), below[w], eastOf(below, w, grid));
+}
+
+// Compute one row of the next generation on a torus
+inline void stepRow(const BitGrid& current, BitGrid& next, int r) {
+    int rows = current.getRows();
+    int wordsPerRow = current.getWordsPerRow();
+    const uint64_t* above = current.row((r - 1 + rows) % rows);
+    const uint64_t* here = current.row(r);
+    const uint64_t* below = current.row((r + 1) % rows);
+    uint64_t* out = next.row(r);
+
+    for (int w = 0; w < wordsPerRow; w++) {
+        out[w] = stepWord(current, above, here, below, w);
+    }
+    out[wordsPerRow - 1] &= current.lastWordMask();
+}
+
+// Compute the whole next generation on a torus; next must have the same dimensions
+inline void stepPacked(const BitGrid& current, BitGrid& next) {
+    for (int r = 0; r < current.getRows(); r++) {
+        stepRow(current, next, r);
+    }
+}
+
+// Contribution of the word at a given index to a grid hash. The grid hash is
+// the XOR of every word's contribution, so changing one word updates it with
+// hash ^= hashWord(old, i) ^ hashWord(new, i) instead of rehashing the grid.
+inline uint64_t hashWord(uint64_t word, std::size_t index) {
+    uint64_t x = word ^ ((index + 1) * 0x9E3779B97F4A7C15ULL);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+inline uint64_t hashGrid(const BitGrid& grid) {
+    uint64_t hash = 0;
+    const uint64_t* words = grid.data();
+    for (std::size_t i = 0; i < grid.wordCount(); i++) {
+        hash ^= hashWord(words[i], i);
+    }
+    return hash;
+}
+
+} // namespace life
+
+#endif // LIFE_BIT_GRID_HPP
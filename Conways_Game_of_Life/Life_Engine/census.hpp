@@ -0,0 +1,395 @@
+// Object census: split a board into objects and name each one
+//
+// Live cells are grouped with a union-find into objects: two cells belong to
+// the same object when they are within two cells of each other (Chebyshev
+// distance), since only then can they share a neighbour and influence each
+// other's next generation. This keeps spaceships such as the LWSS, whose cells
+// are not all touching, in one piece. A group that is not a known object is
+// split into its touching (8-connected) parts, and if all of those are known
+// they are counted separately, so close neighbours in ash such as two
+// blinkers two cells apart are still recognised.
+//
+// Each object is reduced to a canonical form - the smallest bitmap encoding
+// over its 8 rotations and reflections - and looked up in a hash map of known
+// objects. The library is built at start-up by running every seed pattern
+// through its period and registering each phase, so oscillators and spaceships
+// are recognised in any phase, orientation and position.
+
+#ifndef LIFE_CENSUS_HPP
+#define LIFE_CENSUS_HPP
+
+#include "bit_grid.hpp"
+#include "pattern_io.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace life {
+
+enum class ObjectKind {
+    STILL_LIFE,
+    OSCILLATOR,
+    SPACESHIP,
+    UNKNOWN
+};
+
+inline const char* objectKindName(ObjectKind kind) {
+    switch (kind) {
+        case ObjectKind::STILL_LIFE: return "still life";
+        case ObjectKind::OSCILLATOR: return "oscillator";
+        case ObjectKind::SPACESHIP: return "spaceship";
+        case ObjectKind::UNKNOWN: return "unknown";
+    }
+    return "unknown";
+}
+
+// A known object; every phase of it maps to the same entry
+struct KnownObject {
+    std::string name;
+    ObjectKind kind;
+    int period;
+    int cells;  // Population of the registered phase
+};
+
+// How often one kind of object occurs on the board
+struct CensusEntry {
+    std::string name;       // Library name, or "unknown (N cells)"
+    ObjectKind kind;
+    int period;             // 0 for unknown objects
+    int count;
+};
+
+// Canonical key of a set of cells: height, width and the row-major bitmap of
+// whichever of the 8 orientations encodes smallest. With orientations 4 only
+// the reflections are tried, not the transposes, which is the symmetry of a
+// torus that is not square.
+inline std::string canonicalForm(const std::vector<std::pair<int, int>>& cells, int orientations = 8) {
+    std::string best;
+    std::vector<std::pair<int, int>> moved(cells.size());
+    for (int t = 0; t < orientations; t++) {
+        int minRow = 0, minCol = 0, maxRow = 0, maxCol = 0;
+        for (std::size_t i = 0; i < cells.size(); i++) {
+            int r = (t & 4) ? cells[i].second : cells[i].first;
+            int c = (t & 4) ? cells[i].first : cells[i].second;
+            if (t & 1) r = -r;
+            if (t & 2) c = -c;
+            moved[i] = std::make_pair(r, c);
+            if (i == 0 || r < minRow) minRow = r;
+            if (i == 0 || c < minCol) minCol = c;
+            if (i == 0 || r > maxRow) maxRow = r;
+            if (i == 0 || c > maxCol) maxCol = c;
+        }
+        uint32_t height = static_cast<uint32_t>(maxRow - minRow + 1);
+        uint32_t width = static_cast<uint32_t>(maxCol - minCol + 1);
+
+        std::string key(8 + (static_cast<std::size_t>(height) * width + 7) / 8, '\0');
+        for (int b = 0; b < 4; b++) {
+            key[b] = static_cast<char>((height >> (24 - 8 * b)) & 0xFF);
+            key[4 + b] = static_cast<char>((width >> (24 - 8 * b)) & 0xFF);
+        }
+        for (const auto& cell : moved) {
+            std::size_t bit = static_cast<std::size_t>(cell.first - minRow) * width + (cell.second - minCol);
+            key[8 + bit / 8] = static_cast<char>(key[8 + bit / 8] | (0x80 >> (bit % 8)));
+        }
+        if (t == 0 || key < best) {
+            best.swap(key);
+        }
+    }
+    return best;
+}
+
+class PatternCensus {
+private:
+    std::unordered_map<std::string, KnownObject> library;
+    int largestKnown;  // Objects with more cells cannot be in the library
+
+    // Scratch reused between boards
+    std::vector<int> cellIndex;     // Per board cell: index into liveCells, or -1
+    std::vector<int> nearby;        // Union-find forest over liveCells: within two cells
+    std::vector<int> touching;      // Union-find forest over liveCells: 8-connected
+    std::vector<std::pair<int, int>> liveCells;
+
+    static int findRoot(std::vector<int>& parent, int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    static void unite(std::vector<int>& parent, int a, int b) {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a != b) {
+            parent[a < b ? b : a] = a < b ? a : b;
+        }
+    }
+
+    // Offset that unwraps coordinates on a ring of the given size so the
+    // largest empty gap falls at the edge, i.e. the component is not split
+    static int unwrapStart(std::vector<int>& coords, int size) {
+        std::sort(coords.begin(), coords.end());
+        coords.erase(std::unique(coords.begin(), coords.end()), coords.end());
+        int start = coords[0];
+        int largestGap = coords[0] + size - coords.back();
+        for (std::size_t i = 1; i < coords.size(); i++) {
+            if (coords[i] - coords[i - 1] > largestGap) {
+                largestGap = coords[i] - coords[i - 1];
+                start = coords[i];
+            }
+        }
+        return start;
+    }
+
+    // Run a seed pattern through its period and register every phase
+    void addObject(const std::string& name, const char* rle, int period) {
+        std::istringstream in(rle);
+        PatternInfo info;
+        std::string error;
+        std::vector<std::pair<int, int>> seed;
+        readRle(in, [&](long long row, long long col, long long length) {
+            for (long long i = 0; i < length; i++) {
+                seed.push_back(std::make_pair(static_cast<int>(row), static_cast<int>(col + i)));
+            }
+        }, info, error);
+
+        // A margin wider than any seed travels in one period keeps the torus from wrapping into it
+        int margin = period + 4;
+        int height = 0, width = 0;
+        for (const auto& cell : seed) {
+            height = std::max(height, cell.first + 1);
+            width = std::max(width, cell.second + 1);
+        }
+        BitGrid current(height + 2 * margin, width + 2 * margin);
+        BitGrid next(current.getRows(), current.getCols());
+        for (const auto& cell : seed) {
+            current.set(cell.first + margin, cell.second + margin, true);
+        }
+        BitGrid first = current;
+
+        // Phases that fall apart into separate groups (two of the
+        // pentadecathlon's) can never be seen whole, so they are not registered
+        std::vector<std::vector<std::pair<int, int>>> phases;
+        for (int p = 0; p < period; p++) {
+            std::vector<std::vector<std::pair<int, int>>> groups;
+            groupCells(current, groups);
+            if (groups.size() == 1) {
+                phases.push_back(groups[0]);
+            }
+            stepPacked(current, next);
+            std::swap(current, next);
+        }
+
+        ObjectKind kind = current != first ? ObjectKind::SPACESHIP
+                        : period == 1 ? ObjectKind::STILL_LIFE : ObjectKind::OSCILLATOR;
+        for (const auto& phase : phases) {
+            int population = static_cast<int>(phase.size());
+            library.emplace(canonicalForm(phase), KnownObject{name, kind, period, population});
+            largestKnown = std::max(largestKnown, population);
+        }
+    }
+
+    // Index the live cells of grid and join them in both forests
+    void linkCells(const BitGrid& grid) {
+        const int rows = grid.getRows();
+        const int cols = grid.getCols();
+        cellIndex.assign(static_cast<std::size_t>(rows) * cols, -1);
+        liveCells.clear();
+        for (int r = 0; r < rows; r++) {
+            const uint64_t* row = grid.row(r);
+            for (int w = 0; w < grid.getWordsPerRow(); w++) {
+                for (uint64_t word = row[w]; word; word &= word - 1) {
+                    int c = w * 64 + __builtin_ctzll(word);
+                    cellIndex[static_cast<std::size_t>(r) * cols + c] = static_cast<int>(liveCells.size());
+                    liveCells.push_back(std::make_pair(r, c));
+                }
+            }
+        }
+
+        // Join each cell with the live cells in the later half of its 5x5 window
+        nearby.resize(liveCells.size());
+        touching.resize(liveCells.size());
+        for (std::size_t i = 0; i < liveCells.size(); i++) {
+            nearby[i] = static_cast<int>(i);
+            touching[i] = static_cast<int>(i);
+        }
+        for (std::size_t i = 0; i < liveCells.size(); i++) {
+            int r = liveCells[i].first;
+            int c = liveCells[i].second;
+            for (int dr = 0; dr <= 2; dr++) {
+                for (int dc = -2; dc <= 2; dc++) {
+                    if (dr == 0 && dc <= 0) continue;
+                    int nr = (r + dr) % rows;
+                    int nc = ((c + dc) % cols + cols) % cols;
+                    int other = cellIndex[static_cast<std::size_t>(nr) * cols + nc];
+                    if (other < 0) continue;
+                    unite(nearby, static_cast<int>(i), other);
+                    if (dr <= 1 && dc >= -1 && dc <= 1) {
+                        unite(touching, static_cast<int>(i), other);
+                    }
+                }
+            }
+        }
+    }
+
+    // Cells of every group of nearby cells, unwrapped off the torus edges
+    void groupCells(const BitGrid& grid, std::vector<std::vector<std::pair<int, int>>>& groups) {
+        linkCells(grid);
+        std::unordered_map<int, std::size_t> groupOf;
+        groups.clear();
+        for (std::size_t i = 0; i < liveCells.size(); i++) {
+            int root = findRoot(nearby, static_cast<int>(i));
+            auto it = groupOf.find(root);
+            if (it == groupOf.end()) {
+                it = groupOf.emplace(root, groups.size()).first;
+                groups.emplace_back();
+            }
+            groups[it->second].push_back(liveCells[i]);
+        }
+    }
+
+    // Library entry for cells already unwrapped into plane coordinates
+    const KnownObject* identify(const std::vector<std::pair<int, int>>& cells) const {
+        if (static_cast<int>(cells.size()) > largestKnown) {
+            return nullptr;
+        }
+        return lookup(canonicalForm(cells));
+    }
+
+    static void tallyObject(std::unordered_map<std::string, CensusEntry>& tally,
+                            const KnownObject* known, int population) {
+        std::string name = known ? known->name : "unknown (" + std::to_string(population) + " cells)";
+        auto it = tally.find(name);
+        if (it == tally.end()) {
+            CensusEntry entry = known ? CensusEntry{name, known->kind, known->period, 0}
+                                      : CensusEntry{name, ObjectKind::UNKNOWN, 0, 0};
+            it = tally.emplace(name, entry).first;
+        }
+        it->second.count++;
+    }
+
+public:
+    PatternCensus() : largestKnown(0) {
+        // Still lifes, most common in ash first
+        addObject("block", "2o$2o!", 1);
+        addObject("beehive", "b2o$o2bo$b2o!", 1);
+        addObject("loaf", "b2o$o2bo$bobo$2bo!", 1);
+        addObject("boat", "2o$obo$bo!", 1);
+        addObject("ship", "2o$obo$b2o!", 1);
+        addObject("tub", "bo$obo$bo!", 1);
+        addObject("pond", "b2o$o2bo$o2bo$b2o!", 1);
+        addObject("long boat", "2o$obo$bobo$2bo!", 1);
+        addObject("barge", "bo$obo$bobo$2bo!", 1);
+        addObject("mango", "b2o$o2bo$bo2bo$2b2o!", 1);
+        addObject("eater 1", "2o$obo$2bo$2b2o!", 1);
+        addObject("aircraft carrier", "2o$o2bo$2b2o!", 1);
+        addObject("snake", "2obo$ob2o!", 1);
+        addObject("bi-block", "2ob2o$2ob2o!", 1);
+
+        // Oscillators
+        addObject("blinker", "3o!", 2);
+        addObject("toad", "b3o$3o!", 2);
+        addObject("beacon", "2o$2o$2b2o$2b2o!", 2);
+        addObject("clock", "2bo$obo$bobo$bo!", 2);
+        addObject("traffic light", "2b3o2b2$o5bo$o5bo$o5bo2$2b3o!", 2);
+        addObject("pulsar", "2b3o3b3o2$o4bobo4bo$o4bobo4bo$o4bobo4bo$2b3o3b3o2$2b3o3b3o$"
+                            "o4bobo4bo$o4bobo4bo$o4bobo4bo2$2b3o3b3o!", 3);
+        addObject("pentadecathlon", "2bo4bo$2ob4ob2o$2bo4bo!", 15);
+
+        // Spaceships
+        addObject("glider", "bo$2bo$3o!", 4);
+        addObject("LWSS", "bo2bo$o$o3bo$4o!", 4);
+        addObject("MWSS", "3bo$bo3bo$o$o4bo$5o!", 4);
+        addObject("HWSS", "3b2o$bo4bo$o$o5bo$6o!", 4);
+    }
+
+    // The library entry for a canonical form, or nullptr
+    const KnownObject* lookup(const std::string& form) const {
+        auto it = library.find(form);
+        return it == library.end() ? nullptr : &it->second;
+    }
+
+    // Whether the board holds at least one object called name
+    bool contains(const BitGrid& grid, const std::string& name) {
+        for (const CensusEntry& entry : take(grid)) {
+            if (entry.name == name) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Count every object on the toroidal board, most frequent first
+    std::vector<CensusEntry> take(const BitGrid& grid) {
+        std::vector<std::vector<std::pair<int, int>>> groups;
+        groupCells(grid, groups);
+
+        std::unordered_map<std::string, CensusEntry> tally;
+        std::vector<int> rowCoords, colCoords;
+        std::vector<const KnownObject*> partObjects;
+        for (auto& cells : groups) {
+            int population = static_cast<int>(cells.size());
+            if (population > largestKnown) {
+                tallyObject(tally, nullptr, population);
+                continue;
+            }
+
+            // Touching parts, keyed by their root, before the coordinates change
+            std::unordered_map<int, std::vector<std::pair<int, int>>> parts;
+            rowCoords.clear();
+            colCoords.clear();
+            for (const auto& cell : cells) {
+                rowCoords.push_back(cell.first);
+                colCoords.push_back(cell.second);
+            }
+            std::vector<int> partRoots;
+            for (const auto& cell : cells) {
+                int index = cellIndex[static_cast<std::size_t>(cell.first) * grid.getCols() + cell.second];
+                partRoots.push_back(findRoot(touching, index));
+            }
+            int rowStart = unwrapStart(rowCoords, grid.getRows());
+            int colStart = unwrapStart(colCoords, grid.getCols());
+            for (std::size_t i = 0; i < cells.size(); i++) {
+                cells[i].first = (cells[i].first - rowStart + grid.getRows()) % grid.getRows();
+                cells[i].second = (cells[i].second - colStart + grid.getCols()) % grid.getCols();
+                parts[partRoots[i]].push_back(cells[i]);
+            }
+
+            const KnownObject* known = identify(cells);
+            if (known || parts.size() == 1) {
+                tallyObject(tally, known, population);
+                continue;
+            }
+            partObjects.clear();
+            for (const auto& part : parts) {
+                const KnownObject* partKnown = identify(part.second);
+                if (!partKnown) break;
+                partObjects.push_back(partKnown);
+            }
+            if (partObjects.size() == parts.size()) {
+                for (const KnownObject* part : partObjects) {
+                    tallyObject(tally, part, part->cells);
+                }
+            } else {
+                tallyObject(tally, nullptr, population);
+            }
+        }
+
+        std::vector<CensusEntry> census;
+        for (const auto& entry : tally) {
+            census.push_back(entry.second);
+        }
+        std::sort(census.begin(), census.end(), [](const CensusEntry& a, const CensusEntry& b) {
+            return a.count != b.count ? a.count > b.count : a.name < b.name;
+        });
+        return census;
+    }
+};
+
+} // namespace life
+
+#endif // LIFE_CENSUS_HPP
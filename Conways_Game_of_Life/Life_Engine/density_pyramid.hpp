@@ -0,0 +1,126 @@
+// Live-cell density mipmaps of a bit-packed grid, for drawing it zoomed out
+//
+// Level k of the pyramid splits the board into 2^k x 2^k blocks and holds the
+// live cells of each block, so a view showing b cells per pixel reads one
+// count per pixel from level log2(b) however large the board is. Levels from
+// BASE_LEVEL up are stored (one 32-bit count per 8x8 block and up, a
+// fraction of the grid's own size); the finer levels are counted straight
+// from the grid words when asked, which costs a few popcounts per block.
+//
+// A cell changing state adjusts one count per stored level, so edits never
+// rebuild the pyramid.
+
+#ifndef LIFE_DENSITY_PYRAMID_HPP
+#define LIFE_DENSITY_PYRAMID_HPP
+
+#include "bit_grid.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class DensityPyramid {
+public:
+    static const int BASE_LEVEL = 3;  // 8x8 blocks, one byte of a row word
+
+private:
+    struct Level {
+        int rows;
+        int cols;
+        std::vector<uint32_t> counts;
+    };
+
+    const BitGrid* grid;
+    std::vector<Level> levels;  // levels[i] is level BASE_LEVEL + i
+
+    // Live cells in rows [r0, r1) and columns [c0, c1) of the grid
+    int countCells(int r0, int r1, int c0, int c1) const {
+        int count = 0;
+        for (int r = r0; r < r1; r++) {
+            const uint64_t* words = grid->row(r);
+            for (int c = c0; c < c1;) {
+                int bit = c & 63;
+                int span = std::min(64 - bit, c1 - c);
+                uint64_t mask = span == 64 ? ~0ULL : ((1ULL << span) - 1) << bit;
+                count += __builtin_popcountll(words[c >> 6] & mask);
+                c += span;
+            }
+        }
+        return count;
+    }
+
+public:
+    DensityPyramid() : grid(nullptr) {}
+
+    // Count every level from scratch; the grid must outlive the pyramid
+    void build(const BitGrid& source) {
+        grid = &source;
+        levels.clear();
+        int rows = source.getRows();
+        int cols = source.getCols();
+        int size = 1 << BASE_LEVEL;
+        Level base;
+        base.rows = (rows + size - 1) / size;
+        base.cols = (cols + size - 1) / size;
+        base.counts.assign(static_cast<std::size_t>(base.rows) * base.cols, 0);
+        for (int r = 0; r < rows; r++) {
+            const uint64_t* words = source.row(r);
+            uint32_t* out = &base.counts[static_cast<std::size_t>(r >> BASE_LEVEL) * base.cols];
+            for (int b = 0; b < base.cols; b++) {
+                uint64_t byte = (words[b >> 3] >> ((b & 7) * 8)) & 0xFF;
+                out[b] += __builtin_popcountll(byte);
+            }
+        }
+        levels.push_back(base);
+
+        // Each level up sums four blocks of the one below
+        while (levels.back().rows > 1 || levels.back().cols > 1) {
+            const Level& below = levels.back();
+            Level up;
+            up.rows = (below.rows + 1) / 2;
+            up.cols = (below.cols + 1) / 2;
+            up.counts.assign(static_cast<std::size_t>(up.rows) * up.cols, 0);
+            for (int r = 0; r < below.rows; r++) {
+                for (int c = 0; c < below.cols; c++) {
+                    up.counts[static_cast<std::size_t>(r / 2) * up.cols + c / 2] +=
+                        below.counts[static_cast<std::size_t>(r) * below.cols + c];
+                }
+            }
+            levels.push_back(up);
+        }
+    }
+
+    // Coarsest level, where one block covers the whole board
+    int getTopLevel() const { return BASE_LEVEL + static_cast<int>(levels.size()) - 1; }
+
+    // Cell (row, col) of the grid just flipped; alive is its new state
+    void cellChanged(int row, int col, bool alive) {
+        for (std::size_t i = 0; i < levels.size(); i++) {
+            int shift = BASE_LEVEL + static_cast<int>(i);
+            uint32_t& count = levels[i].counts[static_cast<std::size_t>(row >> shift) * levels[i].cols + (col >> shift)];
+            count = alive ? count + 1 : count - 1;
+        }
+    }
+
+    // Live cells of block (blockRow, blockCol) at level
+    int count(int level, int blockRow, int blockCol) const {
+        if (level >= BASE_LEVEL) {
+            const Level& stored = levels[level - BASE_LEVEL];
+            return static_cast<int>(stored.counts[static_cast<std::size_t>(blockRow) * stored.cols + blockCol]);
+        }
+        int r0 = blockRow << level;
+        int c0 = blockCol << level;
+        return countCells(r0, std::min(grid->getRows(), r0 + (1 << level)), c0,
+                          std::min(grid->getCols(), c0 + (1 << level)));
+    }
+
+    // Fraction of the block's cells that are alive; blocks on the board's
+    // edge are measured against the cells they really hold
+    float density(int level, int blockRow, int blockCol) const {
+        int r0 = blockRow << level;
+        int c0 = blockCol << level;
+        int area = (std::min(grid->getRows(), r0 + (1 << level)) - r0) * (std::min(grid->getCols(), c0 + (1 << level)) - c0);
+        return area > 0 ? static_cast<float>(count(level, blockRow, blockCol)) / area : 0.0f;
+    }
+};
+
+#endif // LIFE_DENSITY_PYRAMID_HPP
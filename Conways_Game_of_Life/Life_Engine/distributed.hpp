@@ -0,0 +1,805 @@
+// Life on a torus split across cooperating processes, with halo exchange
+//
+// The board is cut into a P x Q grid of blocks and every block is owned by
+// one process (a rank), so no process ever holds more than its own block: the
+// board can outgrow the memory, and the NUMA domain, of any one process.
+// Block rows are split by rows and block columns by whole words, so no two
+// ranks ever share a word of the board.
+//
+// A rank keeps its block in a BitGrid with a one-cell halo: a row above and
+// below, and a whole word to the west whose top bit is the column left of the
+// block, so the block itself stays word-aligned and is copied in and out with
+// memcpy. The torus kernels step the whole padded grid; every block cell
+// reads only the block and its halo, and the halo's own next state is junk
+// that the next exchange overwrites.
+//
+// Every generation a rank sends its edge rows, edge columns and corner cells
+// to its eight neighbours (the neighbour blocks on the torus, possibly itself
+// or one rank in several directions) and receives their edges into its halo.
+// The exchange overlaps the computation: the sends are started, the cells
+// that read no halo cell are computed while the data is in flight, then the
+// halo is filled in and the border rows and words are computed.
+//
+// Ranks talk over TCP, one connection per neighbouring pair, with
+// non-blocking sockets driven by poll(). runRank() takes every rank's
+// endpoint, so ranks may live on different hosts sharing the board files;
+// runLocal() forks all the ranks of one host and connects them over
+// loopback. The board is read from and written to raw snapshot files
+// (out_of_core.hpp), each rank mapping only its own rows.
+//
+// Sockets and fork() are POSIX only; on Windows a run reports an error.
+
+#ifndef LIFE_DISTRIBUTED_HPP
+#define LIFE_DISTRIBUTED_HPP
+
+#include "out_of_core.hpp"
+#include "parallel_step.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// Directions from a block to its neighbours
+enum class HaloDirection {
+    NORTH,
+    SOUTH,
+    WEST,
+    EAST,
+    NORTH_WEST,
+    NORTH_EAST,
+    SOUTH_WEST,
+    SOUTH_EAST
+};
+
+const int HALO_DIRECTION_COUNT = 8;
+
+// How a torus is cut into blocks; rank r owns block row r / Q, block column r % Q
+class BlockLayout {
+private:
+    int rows;
+    int cols;
+    int blockRows;
+    int blockCols;
+
+    int totalWords() const { return (cols + 63) / 64; }
+
+public:
+    BlockLayout(int boardRows = 0, int boardCols = 0, int p = 1, int q = 1)
+        : rows(boardRows), cols(boardCols), blockRows(p), blockCols(q) {}
+
+    // Every block needs at least one row and one word
+    bool isValid() const {
+        return blockRows >= 1 && blockCols >= 1 && blockRows <= rows && blockCols <= totalWords();
+    }
+
+    int getRanks() const { return blockRows * blockCols; }
+    int getBlockRows() const { return blockRows; }
+    int getBlockCols() const { return blockCols; }
+
+    // Board rows [rowBegin, rowEnd) and columns [colBegin, colEnd) of a rank
+    int rowBegin(int rank) const { return static_cast<int>(static_cast<long long>(rows) * (rank / blockCols) / blockRows); }
+    int rowEnd(int rank) const { return static_cast<int>(static_cast<long long>(rows) * (rank / blockCols + 1) / blockRows); }
+    int wordBegin(int rank) const {
+        return static_cast<int>(static_cast<long long>(totalWords()) * (rank % blockCols) / blockCols);
+    }
+    int colBegin(int rank) const { return wordBegin(rank) * 64; }
+    int colEnd(int rank) const {
+        int words = static_cast<int>(static_cast<long long>(totalWords()) * (rank % blockCols + 1) / blockCols);
+        return std::min(cols, words * 64);
+    }
+
+    static HaloDirection opposite(HaloDirection direction) {
+        switch (direction) {
+            case HaloDirection::NORTH: return HaloDirection::SOUTH;
+            case HaloDirection::SOUTH: return HaloDirection::NORTH;
+            case HaloDirection::WEST: return HaloDirection::EAST;
+            case HaloDirection::EAST: return HaloDirection::WEST;
+            case HaloDirection::NORTH_WEST: return HaloDirection::SOUTH_EAST;
+            case HaloDirection::NORTH_EAST: return HaloDirection::SOUTH_WEST;
+            case HaloDirection::SOUTH_WEST: return HaloDirection::NORTH_EAST;
+            default: return HaloDirection::NORTH_WEST;
+        }
+    }
+
+    // The rank whose block lies in direction from rank's, wrapping around the torus
+    int neighbor(int rank, HaloDirection direction) const {
+        int dr = 0;
+        int dc = 0;
+        switch (direction) {
+            case HaloDirection::NORTH: dr = -1; break;
+            case HaloDirection::SOUTH: dr = 1; break;
+            case HaloDirection::WEST: dc = -1; break;
+            case HaloDirection::EAST: dc = 1; break;
+            case HaloDirection::NORTH_WEST: dr = -1; dc = -1; break;
+            case HaloDirection::NORTH_EAST: dr = -1; dc = 1; break;
+            case HaloDirection::SOUTH_WEST: dr = 1; dc = -1; break;
+            case HaloDirection::SOUTH_EAST: dr = 1; dc = 1; break;
+        }
+        int r = (rank / blockCols + dr + blockRows) % blockRows;
+        int c = (rank % blockCols + dc + blockCols) % blockCols;
+        return r * blockCols + c;
+    }
+};
+
+// Where a rank can be reached
+struct RankEndpoint {
+    std::string host;
+    int port;
+};
+
+// Word messages to and from a rank's neighbours over TCP
+class HaloTransport {
+public:
+    struct Link {
+        int peer;
+        int fd;
+        std::vector<uint64_t> outgoing;
+        std::vector<uint64_t> incoming;
+        std::size_t sent;      // Bytes of outgoing written so far
+        std::size_t received;  // Bytes of incoming read so far
+    };
+
+private:
+    std::vector<Link> links;
+
+    static const int CONNECT_ATTEMPTS = 200;  // Retries while a peer on another host starts
+    static const int CONNECT_RETRY_MS = 50;
+    static const int HALO_TIMEOUT_MS = 10000;  // Longest one exchange may take before a neighbour counts as lost
+
+#if !defined(_WIN32)
+    static bool sendAll(int fd, const void* data, std::size_t bytes) {
+        const char* p = static_cast<const char*>(data);
+        while (bytes > 0) {
+            ssize_t n = ::send(fd, p, bytes, MSG_NOSIGNAL);
+            if (n <= 0) {
+                if (n < 0 && errno == EINTR) continue;
+                return false;
+            }
+            p += n;
+            bytes -= static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    static bool recvAll(int fd, void* data, std::size_t bytes) {
+        char* p = static_cast<char*>(data);
+        while (bytes > 0) {
+            ssize_t n = ::recv(fd, p, bytes, 0);
+            if (n <= 0) {
+                if (n < 0 && errno == EINTR) continue;
+                return false;
+            }
+            p += n;
+            bytes -= static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    static int dial(const RankEndpoint& endpoint) {
+        addrinfo hints = {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* found = nullptr;
+        if (getaddrinfo(endpoint.host.c_str(), std::to_string(endpoint.port).c_str(), &hints, &found) != 0) {
+            return -1;
+        }
+        int fd = -1;
+        for (addrinfo* a = found; a && fd < 0; a = a->ai_next) {
+            fd = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+            if (fd >= 0 && ::connect(fd, a->ai_addr, a->ai_addrlen) != 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+        freeaddrinfo(found);
+        return fd;
+    }
+
+    // Move as many bytes as the sockets take without blocking; true once all are through
+    bool pump(bool& failed) {
+        bool complete = true;
+        for (Link& link : links) {
+            std::size_t outBytes = link.outgoing.size() * sizeof(uint64_t);
+            while (link.sent < outBytes) {
+                ssize_t n = ::send(link.fd, reinterpret_cast<const char*>(link.outgoing.data()) + link.sent,
+                                   outBytes - link.sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+                if (n > 0) {
+                    link.sent += static_cast<std::size_t>(n);
+                } else {
+                    failed = failed || n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+                    break;
+                }
+            }
+            std::size_t inBytes = link.incoming.size() * sizeof(uint64_t);
+            while (link.received < inBytes) {
+                ssize_t n = ::recv(link.fd, reinterpret_cast<char*>(link.incoming.data()) + link.received,
+                                   inBytes - link.received, MSG_DONTWAIT);
+                if (n > 0) {
+                    link.received += static_cast<std::size_t>(n);
+                } else {
+                    failed = failed || n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+                    break;
+                }
+            }
+            complete = complete && link.sent == outBytes && link.received == inBytes;
+        }
+        return complete;
+    }
+#endif
+
+public:
+    HaloTransport() = default;
+    HaloTransport(const HaloTransport&) = delete;
+    HaloTransport& operator=(const HaloTransport&) = delete;
+    ~HaloTransport() { close(); }
+
+    // A socket listening on port of every interface (0 picks a free port,
+    // returned in port); -1 and error on failure
+    static int listenOn(int& port, std::string& error) {
+#if defined(_WIN32)
+        (void)port;
+        error = "distributed runs need POSIX sockets";
+        return -1;
+#else
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        if (fd >= 0) {
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        }
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        socklen_t length = sizeof(address);
+        if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(fd, HALO_DIRECTION_COUNT) != 0 ||
+            getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            error = std::string("cannot listen: ") + std::strerror(errno);
+            if (fd >= 0) ::close(fd);
+            return -1;
+        }
+        port = ntohs(address.sin_port);
+        return fd;
+#endif
+    }
+
+    // Connect rank to each of peers: it dials the higher ranks at their
+    // endpoints and accepts the lower ones on listener, which is then closed
+    bool connect(int rank, const std::vector<RankEndpoint>& endpoints, int listener, const std::vector<int>& peers,
+                 std::string& error) {
+#if defined(_WIN32)
+        (void)rank; (void)endpoints; (void)listener; (void)peers;
+        error = "distributed runs need POSIX sockets";
+        return false;
+#else
+        close();
+        int32_t self = rank;
+        int accepting = 0;
+        for (int peer : peers) {
+            if (peer < rank) {
+                accepting++;
+                continue;
+            }
+            int fd = -1;
+            for (int attempt = 0; fd < 0 && attempt < CONNECT_ATTEMPTS; attempt++) {
+                fd = dial(endpoints[peer]);
+                if (fd < 0) {
+                    const int retryMs = CONNECT_RETRY_MS;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(retryMs));
+                }
+            }
+            if (fd < 0 || !sendAll(fd, &self, sizeof(self))) {
+                error = "cannot reach rank " + std::to_string(peer) + " at " + endpoints[peer].host + ":" +
+                        std::to_string(endpoints[peer].port);
+                if (fd >= 0) ::close(fd);
+                return false;
+            }
+            links.push_back(Link{peer, fd, {}, {}, 0, 0});
+        }
+        // Lower ranks get as long to dial in as this rank gives the higher ones
+        const int retryMs = CONNECT_RETRY_MS;
+        std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(CONNECT_ATTEMPTS * retryMs);
+        for (int i = 0; i < accepting; i++) {
+            pollfd waiting = {listener, POLLIN, 0};
+            int ready = 0;
+            while (ready == 0) {
+                long long left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                if (left <= 0) break;
+                ready = ::poll(&waiting, 1, static_cast<int>(left));
+                if (ready < 0 && errno == EINTR) ready = 0;
+            }
+            if (ready <= 0) {
+                error = "rank " + std::to_string(rank) + " timed out waiting for its lower neighbours to connect";
+                return false;
+            }
+            int fd = ::accept(listener, nullptr, nullptr);
+            int32_t peer = -1;
+            if (fd < 0 || !recvAll(fd, &peer, sizeof(peer)) ||
+                std::find(peers.begin(), peers.end(), peer) == peers.end()) {
+                error = "unexpected connection to rank " + std::to_string(rank);
+                if (fd >= 0) ::close(fd);
+                return false;
+            }
+            links.push_back(Link{peer, fd, {}, {}, 0, 0});
+        }
+        ::close(listener);
+
+        // Halo messages are small and latency bound
+        for (Link& link : links) {
+            int noDelay = 1;
+            setsockopt(link.fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        }
+        std::sort(links.begin(), links.end(), [](const Link& a, const Link& b) { return a.peer < b.peer; });
+        return true;
+#endif
+    }
+
+    void close() {
+#if !defined(_WIN32)
+        for (Link& link : links) {
+            ::close(link.fd);
+        }
+#endif
+        links.clear();
+    }
+
+    int getLinkCount() const { return static_cast<int>(links.size()); }
+    Link& link(int i) { return links[i]; }
+
+    // Index of the link to peer, -1 if there is none
+    int linkTo(int peer) const {
+        for (std::size_t i = 0; i < links.size(); i++) {
+            if (links[i].peer == peer) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    // Start sending every link's outgoing message, with incoming sized for
+    // the reply, and return without waiting
+    void begin() {
+        for (Link& link : links) {
+            link.sent = 0;
+            link.received = 0;
+        }
+#if !defined(_WIN32)
+        bool failed = false;
+        pump(failed);
+#endif
+    }
+
+    // Wait until every message is sent and every reply received, giving up
+    // if the exchange takes longer than HALO_TIMEOUT_MS
+    bool finish(std::string& error) {
+#if defined(_WIN32)
+        error = "distributed runs need POSIX sockets";
+        return false;
+#else
+        bool failed = false;
+        std::vector<pollfd> waiting;
+        const int timeoutMs = HALO_TIMEOUT_MS;
+        std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (!pump(failed)) {
+            if (failed) {
+                error = "lost the connection to a neighbouring rank";
+                return false;
+            }
+            waiting.clear();
+            for (const Link& link : links) {
+                short events = 0;
+                if (link.sent < link.outgoing.size() * sizeof(uint64_t)) events |= POLLOUT;
+                if (link.received < link.incoming.size() * sizeof(uint64_t)) events |= POLLIN;
+                if (events) waiting.push_back(pollfd{link.fd, events, 0});
+            }
+            long long left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            int ready = left > 0 ? ::poll(waiting.data(), waiting.size(), static_cast<int>(left)) : 0;
+            if (ready < 0 && errno != EINTR) {
+                error = std::string("poll failed: ") + std::strerror(errno);
+                return false;
+            }
+            if (ready == 0) {
+                error = "timed out waiting for a neighbouring rank's halo";
+                return false;
+            }
+        }
+        return true;
+#endif
+    }
+};
+
+// One rank's block of the board and its halo
+class BlockStepper {
+public:
+    // What a rank reports when it is done
+    struct Result {
+        int32_t rank;
+        int32_t ok;
+        int64_t population;
+        uint64_t checksum;    // XOR of the block's life::hashWord terms in the board's word order
+        double seconds;
+        double waitSeconds;   // Time spent waiting on neighbours after the overlapped cells were done
+        char error[160];
+    };
+
+private:
+    BlockLayout layout;
+    int rank;
+    int height;       // Block rows; grid rows 1..height
+    int width;        // Block columns; grid columns 64..64 + width - 1
+    int blockWords;   // Words holding the block; grid words 1..blockWords
+    int columnWords;  // Words of one packed edge column
+    BitGrid current;
+    BitGrid next;
+    HaloTransport transport;
+    int linkOf[HALO_DIRECTION_COUNT];  // Link carrying each direction, -1 for the rank itself
+    std::vector<uint64_t> selfMessage;
+    std::vector<std::size_t> offsets;  // Words of each link's message packed or unpacked so far
+
+    static const int WEST_HALO_COL = 63;
+    static const int BLOCK_COL = 64;
+
+    int pieceWords(HaloDirection direction) const {
+        switch (direction) {
+            case HaloDirection::NORTH:
+            case HaloDirection::SOUTH: return blockWords;
+            case HaloDirection::WEST:
+            case HaloDirection::EAST: return columnWords;
+            default: return 1;
+        }
+    }
+
+    void packColumn(int col, uint64_t* out) const {
+        std::fill(out, out + columnWords, 0);
+        for (int r = 0; r < height; r++) {
+            out[r >> 6] |= static_cast<uint64_t>(current.get(r + 1, col)) << (r & 63);
+        }
+    }
+
+    void unpackColumn(int col, const uint64_t* in) {
+        for (int r = 0; r < height; r++) {
+            current.set(r + 1, col, (in[r >> 6] >> (r & 63)) & 1ULL);
+        }
+    }
+
+    // The block's edge facing direction, as the neighbour there needs it
+    void pack(HaloDirection direction, uint64_t* out) const {
+        const int east = BLOCK_COL + width - 1;
+        switch (direction) {
+            case HaloDirection::NORTH: std::memcpy(out, current.row(1) + 1, blockWords * sizeof(uint64_t)); break;
+            case HaloDirection::SOUTH: std::memcpy(out, current.row(height) + 1, blockWords * sizeof(uint64_t)); break;
+            case HaloDirection::WEST: packColumn(BLOCK_COL, out); break;
+            case HaloDirection::EAST: packColumn(east, out); break;
+            case HaloDirection::NORTH_WEST: out[0] = current.get(1, BLOCK_COL); break;
+            case HaloDirection::NORTH_EAST: out[0] = current.get(1, east); break;
+            case HaloDirection::SOUTH_WEST: out[0] = current.get(height, BLOCK_COL); break;
+            case HaloDirection::SOUTH_EAST: out[0] = current.get(height, east); break;
+        }
+    }
+
+    // Fill the halo on the side facing direction from that neighbour's edge
+    void unpack(HaloDirection direction, const uint64_t* in) {
+        const int east = BLOCK_COL + width;
+        switch (direction) {
+            case HaloDirection::NORTH: std::memcpy(current.row(0) + 1, in, blockWords * sizeof(uint64_t)); break;
+            case HaloDirection::SOUTH: std::memcpy(current.row(height + 1) + 1, in, blockWords * sizeof(uint64_t)); break;
+            case HaloDirection::WEST: unpackColumn(WEST_HALO_COL, in); break;
+            case HaloDirection::EAST: unpackColumn(east, in); break;
+            case HaloDirection::NORTH_WEST: current.set(0, WEST_HALO_COL, in[0] & 1ULL); break;
+            case HaloDirection::NORTH_EAST: current.set(0, east, in[0] & 1ULL); break;
+            case HaloDirection::SOUTH_WEST: current.set(height + 1, WEST_HALO_COL, in[0] & 1ULL); break;
+            case HaloDirection::SOUTH_EAST: current.set(height + 1, east, in[0] & 1ULL); break;
+        }
+    }
+
+public:
+    BlockStepper(const BlockLayout& blockLayout, int blockRank)
+        : layout(blockLayout), rank(blockRank),
+          height(blockLayout.rowEnd(blockRank) - blockLayout.rowBegin(blockRank)),
+          width(blockLayout.colEnd(blockRank) - blockLayout.colBegin(blockRank)),
+          blockWords((width + 63) / 64), columnWords((height + 63) / 64),
+          current(height + 2, BLOCK_COL + width + 1), next(height + 2, BLOCK_COL + width + 1) {}
+
+    // Copy the block out of the board file
+    void load(const MappedBoardFile& board) {
+        const int first = layout.rowBegin(rank);
+        const int word = layout.wordBegin(rank);
+        for (int r = 0; r < height; r++) {
+            std::memcpy(current.row(r + 1) + 1, board.row(first + r) + word, blockWords * sizeof(uint64_t));
+        }
+    }
+
+    // Connect to the neighbouring ranks and size their messages
+    bool connect(const std::vector<RankEndpoint>& endpoints, int listener, std::string& error) {
+        std::vector<int> peers;
+        for (int d = 0; d < HALO_DIRECTION_COUNT; d++) {
+            int peer = layout.neighbor(rank, static_cast<HaloDirection>(d));
+            if (peer != rank && std::find(peers.begin(), peers.end(), peer) == peers.end()) {
+                peers.push_back(peer);
+            }
+        }
+        if (!transport.connect(rank, endpoints, listener, peers, error)) {
+            return false;
+        }
+
+        // A message to a peer holds the edges for every direction it lies in,
+        // in direction order; as the peer sees us in the opposite directions,
+        // its reply is sized the same way
+        std::size_t selfWords = 0;
+        for (int d = 0; d < HALO_DIRECTION_COUNT; d++) {
+            HaloDirection direction = static_cast<HaloDirection>(d);
+            int peer = layout.neighbor(rank, direction);
+            linkOf[d] = peer == rank ? -1 : transport.linkTo(peer);
+            if (linkOf[d] < 0) {
+                selfWords += pieceWords(direction);
+            } else {
+                transport.link(linkOf[d]).outgoing.resize(transport.link(linkOf[d]).outgoing.size() + pieceWords(direction));
+            }
+        }
+        for (int i = 0; i < transport.getLinkCount(); i++) {
+            transport.link(i).incoming.resize(transport.link(i).outgoing.size());
+        }
+        selfMessage.resize(selfWords);
+        offsets.assign(transport.getLinkCount(), 0);
+        return true;
+    }
+
+    // Advance the block one generation, exchanging halos with the neighbours;
+    // waitSeconds grows by the time spent blocked on them
+    bool step(ThreadPool& pool, const life::RuleKernel& kernel, double& waitSeconds, std::string& error) {
+        std::fill(offsets.begin(), offsets.end(), 0);
+        std::size_t selfOffset = 0;
+        for (int d = 0; d < HALO_DIRECTION_COUNT; d++) {
+            HaloDirection direction = static_cast<HaloDirection>(d);
+            if (linkOf[d] < 0) {
+                pack(direction, selfMessage.data() + selfOffset);
+                selfOffset += pieceWords(direction);
+            } else {
+                pack(direction, transport.link(linkOf[d]).outgoing.data() + offsets[linkOf[d]]);
+                offsets[linkOf[d]] += pieceWords(direction);
+            }
+        }
+        transport.begin();
+
+        // Cells that read no halo cell, while the edges are in flight
+        const int lastWord = blockWords;
+        life::stepRegionParallel(current, next, pool, kernel, 2, height, 2, lastWord);
+
+        std::chrono::steady_clock::time_point waitStart = std::chrono::steady_clock::now();
+        if (!transport.finish(error)) {
+            return false;
+        }
+        waitSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - waitStart).count();
+
+        // A neighbour's edge facing us fills our side facing it: the piece it
+        // sent in direction d lands on our side opposite d
+        std::fill(offsets.begin(), offsets.end(), 0);
+        selfOffset = 0;
+        for (int d = 0; d < HALO_DIRECTION_COUNT; d++) {
+            HaloDirection direction = static_cast<HaloDirection>(d);
+            HaloDirection side = BlockLayout::opposite(direction);
+            if (linkOf[d] < 0) {
+                unpack(side, selfMessage.data() + selfOffset);
+                selfOffset += pieceWords(direction);
+            }
+            int from = linkOf[static_cast<int>(side)];
+            if (from >= 0) {
+                unpack(side, transport.link(from).incoming.data() + offsets[from]);
+                offsets[from] += pieceWords(direction);
+            }
+        }
+
+        // The border rows, then the edge words of the rows between them
+        life::stepRegionParallel(current, next, pool, kernel, 1, 2, 1, lastWord + 1);
+        if (height > 1) {
+            life::stepRegionParallel(current, next, pool, kernel, height, height + 1, 1, lastWord + 1);
+        }
+        life::stepRegionParallel(current, next, pool, kernel, 2, height, 1, 2);
+        if (lastWord > 1) {
+            life::stepRegionParallel(current, next, pool, kernel, 2, height, lastWord, lastWord + 1);
+        }
+        std::swap(current, next);
+        return true;
+    }
+
+    // Write the block into the board file; returns its checksum terms
+    uint64_t store(MappedBoardFile& board, long long& population) const {
+        const int first = layout.rowBegin(rank);
+        const int word = layout.wordBegin(rank);
+        const std::size_t boardWords = static_cast<std::size_t>(board.getWordsPerRow());
+        const uint64_t lastMask = width % 64 == 0 ? ~0ULL : (1ULL << (width % 64)) - 1;
+        uint64_t checksum = 0;
+        population = 0;
+        for (int r = 0; r < height; r++) {
+            uint64_t* to = board.row(first + r) + word;
+            const uint64_t* from = current.row(r + 1) + 1;
+            for (int w = 0; w < blockWords; w++) {
+                to[w] = w == blockWords - 1 ? from[w] & lastMask : from[w];
+                population += __builtin_popcountll(to[w]);
+                checksum ^= life::hashWord(to[w], (first + r) * boardWords + word + w);
+            }
+        }
+        return checksum;
+    }
+};
+
+class DistributedRun {
+public:
+    // Run one rank to the end: read its block from inputPath, step it
+    // generations with its neighbours and write it into outputPath, which
+    // must already exist with the board's dimensions
+    static BlockStepper::Result runRank(const BlockLayout& layout, int rank, const std::vector<RankEndpoint>& endpoints,
+                                        int listener, const std::string& inputPath, const std::string& outputPath,
+                                        long long generations, int threads, const life::Rule& rule) {
+        BlockStepper::Result result = {};
+        result.rank = rank;
+        std::string error;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        BlockStepper block(layout, rank);
+        MappedBoardFile input;
+        bool ok = input.open(inputPath, false, error);
+        if (ok) {
+            block.load(input);
+            input.close();
+            ok = block.connect(endpoints, listener, error);
+        }
+
+        ThreadPool pool(threads);
+        const life::RuleKernel kernel = life::fastRuleKernel(rule);
+        double waitSeconds = 0;
+        for (long long g = 0; ok && g < generations; g++) {
+            ok = block.step(pool, kernel, waitSeconds, error);
+        }
+
+        MappedBoardFile output;
+        if (ok && output.open(outputPath, true, error)) {
+            long long population = 0;
+            result.checksum = block.store(output, population);
+            result.population = population;
+            output.close();
+        } else {
+            ok = false;
+        }
+        result.ok = ok;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.waitSeconds = waitSeconds;
+        std::strncpy(result.error, error.c_str(), sizeof(result.error) - 1);
+        return result;
+    }
+
+    // Run the board in inputPath for generations as p x q ranks forked on
+    // this host and connected over loopback, leaving the result in
+    // outputPath. The ranks' results come back in results, by rank.
+    static bool runLocal(const std::string& inputPath, const std::string& outputPath, long long generations, int p,
+                         int q, int threadsPerRank, const life::Rule& rule, std::vector<BlockStepper::Result>& results,
+                         std::string& error) {
+#if defined(_WIN32)
+        (void)inputPath; (void)outputPath; (void)generations; (void)p; (void)q; (void)threadsPerRank; (void)rule;
+        (void)results;
+        error = "distributed runs need POSIX sockets and fork()";
+        return false;
+#else
+        if (inputPath == outputPath) {
+            error = "the output must be a different file from the input";
+            return false;
+        }
+        MappedBoardFile source;
+        if (!source.open(inputPath, false, error)) {
+            return false;
+        }
+        BlockLayout layout(source.getRows(), source.getCols(), p, q);
+        if (!layout.isValid()) {
+            error = "a " + std::to_string(p) + "x" + std::to_string(q) + " split needs at least one row and 64 columns per block";
+            return false;
+        }
+        life::SnapshotInfo info = source.getInfo();
+        info.generation += generations;
+        info.rule = life::ruleString(rule);
+        MappedBoardFile target;
+        if (!target.create(outputPath, source.getRows(), source.getCols(), info, error)) {
+            return false;
+        }
+        target.close();
+        source.close();
+
+        // Every listener exists before any rank starts, so no dial is refused
+        const int ranks = layout.getRanks();
+        std::vector<int> listeners(ranks, -1);
+        std::vector<RankEndpoint> endpoints(ranks);
+        bool listening = true;
+        for (int r = 0; r < ranks && listening; r++) {
+            endpoints[r] = RankEndpoint{"127.0.0.1", 0};
+            listeners[r] = HaloTransport::listenOn(endpoints[r].port, error);
+            listening = listeners[r] >= 0;
+        }
+        int pipeFds[2] = {-1, -1};
+        if (!listening || ::pipe(pipeFds) != 0) {
+            for (int fd : listeners) if (fd >= 0) ::close(fd);
+            if (listening) error = "cannot create the result pipe";
+            return false;
+        }
+
+        // Anything buffered would otherwise be written once more by every rank
+        std::fflush(nullptr);
+        std::vector<pid_t> children;
+        for (int r = 0; r < ranks; r++) {
+            pid_t pid = ::fork();
+            if (pid == 0) {
+                ::close(pipeFds[0]);
+                for (int other = 0; other < ranks; other++) {
+                    if (other != r) ::close(listeners[other]);
+                }
+                BlockStepper::Result result = runRank(layout, r, endpoints, listeners[r], inputPath, outputPath,
+                                                      generations, threadsPerRank, rule);
+                // Smaller than PIPE_BUF, so results from different ranks never interleave
+                bool written = ::write(pipeFds[1], &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result));
+                ::_exit(written && result.ok ? 0 : 1);
+            }
+            if (pid < 0) {
+                error = "cannot start rank " + std::to_string(r);
+                break;
+            }
+            children.push_back(pid);
+        }
+        ::close(pipeFds[1]);
+        for (int fd : listeners) ::close(fd);
+
+        results.assign(ranks, BlockStepper::Result());
+        std::vector<bool> reported(ranks, false);
+        BlockStepper::Result result;
+        while (static_cast<int>(children.size()) == ranks &&
+               ::read(pipeFds[0], &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result))) {
+            if (result.rank >= 0 && result.rank < ranks) {
+                results[result.rank] = result;
+                reported[result.rank] = true;
+            }
+        }
+        ::close(pipeFds[0]);
+        bool ok = static_cast<int>(children.size()) == ranks;
+        for (pid_t pid : children) {
+            if (!ok) ::kill(pid, SIGTERM);
+            int status = 0;
+            ::waitpid(pid, &status, 0);
+        }
+        if (!ok) {
+            return false;
+        }
+
+        uint64_t checksum = 0;
+        for (int r = 0; r < ranks; r++) {
+            if (!reported[r] || !results[r].ok) {
+                error = "rank " + std::to_string(r) + " failed" +
+                        (reported[r] && results[r].error[0] ? std::string(": ") + results[r].error : std::string());
+                return false;
+            }
+            checksum ^= results[r].checksum;
+        }
+        if (!target.open(outputPath, true, error)) {
+            return false;
+        }
+        target.setChecksum(checksum);
+        return true;
+#endif
+    }
+};
+
+#endif // LIFE_DISTRIBUTED_HPP
@@ -0,0 +1,177 @@
+// Compile-time sized torus for small puzzle boards
+//
+// FixedGrid<Rows, Cols> stores its cells inline in a std::array, laid out
+// exactly like BitGrid (64 cells per word, zero padding past the last column),
+// so a board is one flat object with no allocation and copying it is a
+// memcpy. The dimensions are template arguments, so the torus wrap - the row
+// above row 0, the column west of column 0 - is folded into constants and the
+// row and word loops have fixed trip counts the compiler can unroll.
+//
+// It offers the same board interface as the game's dynamic Grid, so code
+// written as a template over the board runs unchanged on either:
+//  - Board(rows, cols), getRows, getCols, getCell, setCell, clear, ==
+//  - countLiveCells, hash (equal to life::hashGrid of the same cells)
+//  - randomFill(density, seed), the same soup as life::fillSoup gives Grid
+//  - Board::Kernel, Board::kernelFor(rule) and stepInto(next, kernel)
+// The word kernel is the rule operation of life_rule.hpp applied one word at
+// a time; at this size the rows are too short for the SIMD kernels to pay off.
+
+#ifndef LIFE_FIXED_GRID_HPP
+#define LIFE_FIXED_GRID_HPP
+
+#include "bit_grid.hpp"
+#include "life_rule.hpp"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace life {
+
+// Generator of a reproducible soup: the same cells for the same seed on every machine
+inline std::mt19937 soupGenerator(uint64_t seed) {
+    std::seed_seq sequence{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+    return std::mt19937(sequence);
+}
+
+// Set every cell of board, row by row, alive with probability density
+template <typename Board>
+void fillSoup(Board& board, std::mt19937& gen, double density) {
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+    for (int i = 0; i < board.getRows(); i++) {
+        for (int j = 0; j < board.getCols(); j++) {
+            board.setCell(i, j, dis(gen) < density);
+        }
+    }
+}
+
+} // namespace life
+
+template <int Rows, int Cols>
+class FixedGrid {
+    static_assert(Rows > 0 && Cols > 0, "a board needs at least one cell");
+
+public:
+    static constexpr int WORDS_PER_ROW = (Cols + 63) / 64;
+    static constexpr int WORD_COUNT = Rows * WORDS_PER_ROW;
+
+    // The rule to step with: the compiled operation for the rules known in
+    // advance, else the table
+    struct Kernel {
+        life::Rule rule;
+        life::RuleTable table;
+    };
+
+private:
+    static constexpr int LAST_BIT = (Cols - 1) & 63;  // Bit of the last column in the last word
+    static constexpr uint64_t LAST_WORD_MASK = Cols % 64 == 0 ? ~0ULL : (1ULL << (Cols % 64)) - 1;
+
+    std::array<uint64_t, WORD_COUNT> words;
+
+    // Row shifted so each bit holds its west neighbour (column - 1), wrapping
+    static uint64_t westOf(const uint64_t* row, int w) {
+        if (w > 0) {
+            return (row[w] << 1) | (row[w - 1] >> 63);
+        }
+        return (row[0] << 1) | ((row[WORDS_PER_ROW - 1] >> LAST_BIT) & 1ULL);
+    }
+
+    // Row shifted so each bit holds its east neighbour (column + 1), wrapping
+    static uint64_t eastOf(const uint64_t* row, int w) {
+        if (w < WORDS_PER_ROW - 1) {
+            return (row[w] >> 1) | (row[w + 1] << 63);
+        }
+        return (row[w] >> 1) | ((row[0] & 1ULL) << LAST_BIT);
+    }
+
+    template <typename Op>
+    void stepWith(FixedGrid& next, const Op& op) const {
+        for (int r = 0; r < Rows; r++) {
+            const uint64_t* above = row(r == 0 ? Rows - 1 : r - 1);
+            const uint64_t* here = row(r);
+            const uint64_t* below = row(r == Rows - 1 ? 0 : r + 1);
+            uint64_t* out = next.row(r);
+            for (int w = 0; w < WORDS_PER_ROW; w++) {
+                op.apply(westOf(above, w), above[w], eastOf(above, w),
+                         westOf(here, w), here[w], eastOf(here, w),
+                         westOf(below, w), below[w], eastOf(below, w), out[w]);
+            }
+            out[WORDS_PER_ROW - 1] &= LAST_WORD_MASK;
+        }
+    }
+
+public:
+    // The dimensions are fixed; they are taken so generic code can build any board alike
+    explicit FixedGrid(int rows = Rows, int cols = Cols) : words() {
+        assert(rows == Rows && cols == Cols);
+        (void)rows;
+        (void)cols;
+    }
+
+    static constexpr int getRows() { return Rows; }
+    static constexpr int getCols() { return Cols; }
+
+    uint64_t* row(int r) { return words.data() + static_cast<std::size_t>(r) * WORDS_PER_ROW; }
+    const uint64_t* row(int r) const { return words.data() + static_cast<std::size_t>(r) * WORDS_PER_ROW; }
+
+    bool getCell(int r, int c) const {
+        return (row(r)[c >> 6] >> (c & 63)) & 1ULL;
+    }
+
+    void setCell(int r, int c, bool alive) {
+        uint64_t bit = 1ULL << (c & 63);
+        if (alive) {
+            row(r)[c >> 6] |= bit;
+        } else {
+            row(r)[c >> 6] &= ~bit;
+        }
+    }
+
+    void clear() {
+        words.fill(0);
+    }
+
+    void randomFill(double density, uint64_t seed) {
+        std::mt19937 gen = life::soupGenerator(seed);
+        life::fillSoup(*this, gen, density);
+    }
+
+    int countLiveCells() const {
+        int count = 0;
+        for (uint64_t w : words) {
+            count += __builtin_popcountll(w);
+        }
+        return count;
+    }
+
+    uint64_t hash() const {
+        uint64_t hash = 0;
+        for (int i = 0; i < WORD_COUNT; i++) {
+            hash ^= life::hashWord(words[i], i);
+        }
+        return hash;
+    }
+
+    bool operator==(const FixedGrid& other) const { return words == other.words; }
+    bool operator!=(const FixedGrid& other) const { return words != other.words; }
+
+    static Kernel kernelFor(const life::Rule& rule) {
+        return Kernel{rule, life::RuleTable(rule)};
+    }
+
+    // Compute the next generation into next
+    void stepInto(FixedGrid& next, const Kernel& kernel) const {
+        if (kernel.rule == life::CONWAY) {
+            stepWith(next, life::ConwayOp());
+        } else if (kernel.rule == life::HIGHLIFE) {
+            stepWith(next, life::HighLifeOp());
+        } else if (kernel.rule == life::DAY_AND_NIGHT) {
+            stepWith(next, life::DayAndNightOp());
+        } else {
+            stepWith(next, life::TableRuleOp(kernel.table));
+        }
+    }
+};
+
+#endif // LIFE_FIXED_GRID_HPP
@@ -0,0 +1,68 @@
+// Bounded single-producer, single-consumer ring of reusable frames
+//
+// The simulation thread fills a slot in place and publishes it; the display
+// thread reads published slots and releases them. Slots are allocated once,
+// so a frame whose buffers keep their size costs no allocation, and the two
+// sides only share the head and tail indices, each written by one side:
+// neither ever takes a lock or waits for the other.
+//
+// A full ring means the consumer is behind, and the producer simply does not
+// publish (claim() returns nullptr). The consumer always skips straight to the
+// newest frame with latest(), dropping the ones it had no time for.
+
+#ifndef LIFE_FRAME_RING_HPP
+#define LIFE_FRAME_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class SpscRing {
+private:
+    std::vector<T> slots;
+    alignas(64) std::atomic<std::size_t> head;  // Next slot to read; written by the consumer
+    alignas(64) std::atomic<std::size_t> tail;  // Next slot to fill; written by the producer
+
+    T& slot(std::size_t index) { return slots[index % slots.size()]; }
+
+public:
+    explicit SpscRing(std::size_t capacity, const T& prototype = T())
+        : slots(capacity, prototype), head(0), tail(0) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer: the slot to fill next, or nullptr while the ring is full
+    T* claim() {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == slots.size()) {
+            return nullptr;
+        }
+        return &slot(t);
+    }
+
+    // Producer: hand the claimed slot to the consumer
+    void publish() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: the newest published frame, releasing every older one, or
+    // nullptr when there is none
+    T* latest() {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        std::size_t t = tail.load(std::memory_order_acquire);
+        if (h == t) {
+            return nullptr;
+        }
+        head.store(t - 1, std::memory_order_release);
+        return &slot(t - 1);
+    }
+
+    // Consumer: give the frame from latest() back to the producer
+    void release() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+#endif // LIFE_FRAME_RING_HPP
@@ -0,0 +1,101 @@
+// Ring of recent generations with a hash history for cycle detection
+//
+// The ring holds the depth - 1 generations before the current one, which the
+// caller keeps in its own buffer. The next generation is written straight
+// into the oldest slot and then swapped with the current buffer, so advancing
+// a generation moves no cells at all.
+//
+// Every slot remembers the grid hash (life::hashGrid) of its generation. A
+// board that has entered a cycle of period p <= depth - 1 matches the hash p
+// slots back, which is checked against a handful of integers per generation;
+// a hash match is confirmed by comparing the grids before it is reported.
+//
+// The ring is a template over the board so fixed-size boards (fixed_grid.hpp)
+// can keep their history inline; a board only needs a (rows, cols)
+// constructor, swap and ==. GenerationRing is the BitGrid ring.
+
+#ifndef LIFE_GENERATION_RING_HPP
+#define LIFE_GENERATION_RING_HPP
+
+#include "bit_grid.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template <typename Board>
+class BasicGenerationRing {
+public:
+    static const int DEFAULT_DEPTH = 8;
+
+private:
+    std::vector<Board> slots;       // Previous generations, newest at head
+    std::vector<uint64_t> hashes;   // Grid hash of each slot
+    int head;
+    int filled;                     // Slots holding real generations since the last reset
+    uint64_t currentHash;
+
+    int slotAgo(int generationsBack) const {
+        int size = static_cast<int>(slots.size());
+        return ((head - (generationsBack - 1)) % size + size) % size;
+    }
+
+public:
+    // depth counts the caller's current buffer, so the ring keeps depth - 1 slots
+    BasicGenerationRing(int depth = DEFAULT_DEPTH, int rows = 0, int cols = 0) {
+        resize(depth, rows, cols);
+    }
+
+    void resize(int depth, int rows, int cols) {
+        if (depth < 2) depth = 2;
+        slots.assign(depth - 1, Board(rows, cols));
+        hashes.assign(depth - 1, 0);
+        head = 0;
+        filled = 0;
+        currentHash = 0;
+    }
+
+    int getDepth() const { return static_cast<int>(slots.size()) + 1; }
+    uint64_t getCurrentHash() const { return currentHash; }
+
+    // Buffer the next generation is computed into. Once the ring is full it
+    // holds the generation depth - 1 before the current one.
+    Board& nextSlot() { return slots[slotAgo(static_cast<int>(slots.size()))]; }
+
+    // The generation before the current one; only valid after one advance()
+    const Board& previous() const { return slots[head]; }
+
+    // Forget the history after the current grid was changed from outside
+    void reset(uint64_t hash) {
+        filled = 0;
+        currentHash = hash;
+    }
+
+    // The next generation has been written into nextSlot(): swap it with the
+    // caller's current buffer, which becomes the newest slot of the history
+    void advance(Board& current, uint64_t nextHash) {
+        int slot = slotAgo(static_cast<int>(slots.size()));
+        std::swap(slots[slot], current);
+        hashes[slot] = currentHash;
+        head = slot;
+        currentHash = nextHash;
+        if (filled < static_cast<int>(slots.size())) {
+            filled++;
+        }
+    }
+
+    // Smallest period p <= depth - 1 with which current repeats the history,
+    // or 0 if it matches none of the remembered generations
+    int findPeriod(const Board& current) const {
+        for (int p = 1; p <= filled; p++) {
+            int slot = slotAgo(p);
+            if (hashes[slot] == currentHash && slots[slot] == current) {
+                return p;
+            }
+        }
+        return 0;
+    }
+};
+
+using GenerationRing = BasicGenerationRing<BitGrid>;
+
+#endif // LIFE_GENERATION_RING_HPP
@@ -0,0 +1,354 @@
+// HashLife engine: memoized quadtree stepping for Life-like rules
+//
+// The universe is a quadtree of canonical (hash-consed) nodes, so identical
+// sub-patterns anywhere in space or time share one node. Each node caches the
+// future of its centre, which lets periodic and structured patterns advance
+// by 2^k generations in time roughly proportional to k instead of 2^k.
+//
+// Nodes of level L cover a 2^L x 2^L square. Level 3 nodes are leaves holding
+// an 8x8 bitmap (bit r*8+c is cell (r, c)); higher levels hold four children.
+//
+// The game board is a torus, which HashLife handles when the board is a
+// square with a power-of-two side of at least 16: stepping a 2x2 tiling of
+// the torus leaves the torus itself, shifted by half its size, in the centre.
+
+#ifndef LIFE_HASHLIFE_HPP
+#define LIFE_HASHLIFE_HPP
+
+#include "bit_grid.hpp"
+#include "life_rule.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class HashLife {
+public:
+    using NodeId = uint32_t;
+    static const NodeId NONE = 0xFFFFFFFFu;
+    static const int LEAF_LEVEL = 3;
+
+private:
+    struct Node {
+        NodeId nw, ne, sw, se;  // Children (NONE for leaves)
+        uint64_t bits;          // 8x8 bitmap for leaves
+        NodeId result;          // Cached centre after 2^resultLog generations
+        int8_t resultLog;       // -1 when nothing is cached
+        uint8_t level;
+        bool marked;            // Garbage collection mark
+        bool inUse;
+    };
+
+    struct NodeKey {
+        uint64_t a;
+        uint64_t b;
+        bool operator==(const NodeKey& other) const { return a == other.a && b == other.b; }
+    };
+
+    struct NodeKeyHash {
+        size_t operator()(const NodeKey& key) const {
+            uint64_t h = key.a * 0x9E3779B97F4A7C15ULL ^ (key.b + 0x632BE59BD9B4E019ULL + (key.a << 6));
+            h ^= h >> 29;
+            return static_cast<size_t>(h * 0xBF58476D1CE4E5B9ULL);
+        }
+    };
+
+    std::vector<Node> nodes;
+    std::vector<NodeId> freeList;
+    std::unordered_map<NodeKey, NodeId, NodeKeyHash> cache;
+    NodeId root;
+    int rootLevel;
+    size_t gcThreshold;
+    bool conway;            // B3/S23 takes the reduced kernel; other rules read the table
+    life::RuleTable ruleTable;
+
+    static NodeKey leafKey(uint64_t bits) { return { bits, ~0ULL }; }
+    static NodeKey innerKey(NodeId nw, NodeId ne, NodeId sw, NodeId se) {
+        return { static_cast<uint64_t>(nw) | (static_cast<uint64_t>(ne) << 32),
+                 static_cast<uint64_t>(sw) | (static_cast<uint64_t>(se) << 32) };
+    }
+
+    NodeId allocate(const Node& node) {
+        if (!freeList.empty()) {
+            NodeId id = freeList.back();
+            freeList.pop_back();
+            nodes[id] = node;
+            return id;
+        }
+        nodes.push_back(node);
+        return static_cast<NodeId>(nodes.size() - 1);
+    }
+
+    // Canonical leaf for an 8x8 bitmap
+    NodeId leaf(uint64_t bits) {
+        NodeKey key = leafKey(bits);
+        auto it = cache.find(key);
+        if (it != cache.end()) return it->second;
+        NodeId id = allocate({ NONE, NONE, NONE, NONE, bits, NONE, -1, LEAF_LEVEL, false, true });
+        cache.emplace(key, id);
+        return id;
+    }
+
+    // Canonical node with the given four children
+    NodeId join(NodeId nw, NodeId ne, NodeId sw, NodeId se) {
+        NodeKey key = innerKey(nw, ne, sw, se);
+        auto it = cache.find(key);
+        if (it != cache.end()) return it->second;
+        uint8_t level = static_cast<uint8_t>(nodes[nw].level + 1);
+        NodeId id = allocate({ nw, ne, sw, se, 0, NONE, -1, level, false, true });
+        cache.emplace(key, id);
+        return id;
+    }
+
+    // Lay four 8x8 leaves out as sixteen 16-bit rows
+    void assemble16(NodeId nw, NodeId ne, NodeId sw, NodeId se, uint64_t rows16[16]) const {
+        for (int r = 0; r < 8; r++) {
+            rows16[r] = ((nodes[nw].bits >> (r * 8)) & 0xFF) | (((nodes[ne].bits >> (r * 8)) & 0xFF) << 8);
+            rows16[r + 8] = ((nodes[sw].bits >> (r * 8)) & 0xFF) | (((nodes[se].bits >> (r * 8)) & 0xFF) << 8);
+        }
+    }
+
+    static uint64_t centre8(const uint64_t rows16[16]) {
+        uint64_t bits = 0;
+        for (int r = 0; r < 8; r++) {
+            bits |= ((rows16[r + 4] >> 4) & 0xFF) << (r * 8);
+        }
+        return bits;
+    }
+
+    // Level 4 base case: centre 8x8 of a 16x16 square after 1, 2 or 4 generations
+    NodeId advanceBase(NodeId id, int generations) {
+        uint64_t rows16[16];
+        assemble16(nodes[id].nw, nodes[id].ne, nodes[id].sw, nodes[id].se, rows16);
+
+        for (int g = 0; g < generations; g++) {
+            uint64_t next[16];
+            for (int r = 0; r < 16; r++) {
+                uint64_t a = r > 0 ? rows16[r - 1] : 0;
+                uint64_t b = rows16[r];
+                uint64_t c = r < 15 ? rows16[r + 1] : 0;
+                next[r] = (conway ? life::conwayWord(a << 1, a, a >> 1, b << 1, b, b >> 1, c << 1, c, c >> 1)
+                                  : life::ruleWord(ruleTable, a << 1, a, a >> 1, b << 1, b, b >> 1, c << 1, c, c >> 1)) & 0xFFFF;
+            }
+            for (int r = 0; r < 16; r++) rows16[r] = next[r];
+        }
+
+        return leaf(centre8(rows16));
+    }
+
+    // Centre half of a node, without advancing time
+    NodeId centre(NodeId id) {
+        NodeId nw = nodes[id].nw, ne = nodes[id].ne, sw = nodes[id].sw, se = nodes[id].se;
+        if (nodes[id].level == LEAF_LEVEL + 1) {
+            uint64_t rows16[16];
+            assemble16(nw, ne, sw, se, rows16);
+            return leaf(centre8(rows16));
+        }
+        return join(nodes[nw].se, nodes[ne].sw, nodes[sw].ne, nodes[se].nw);
+    }
+
+    // Centre half of a level-L node after 2^stepLog generations (stepLog <= L - 2)
+    NodeId advance(NodeId id, int stepLog) {
+        if (nodes[id].resultLog == stepLog) return nodes[id].result;
+
+        NodeId result;
+        if (nodes[id].level == LEAF_LEVEL + 1) {
+            result = advanceBase(id, 1 << stepLog);
+        } else {
+            NodeId nw = nodes[id].nw, ne = nodes[id].ne, sw = nodes[id].sw, se = nodes[id].se;
+
+            // Nine overlapping squares of half this node's size
+            NodeId n00 = nw;
+            NodeId n01 = join(nodes[nw].ne, nodes[ne].nw, nodes[nw].se, nodes[ne].sw);
+            NodeId n02 = ne;
+            NodeId n10 = join(nodes[nw].sw, nodes[nw].se, nodes[sw].nw, nodes[sw].ne);
+            NodeId n11 = join(nodes[nw].se, nodes[ne].sw, nodes[sw].ne, nodes[se].nw);
+            NodeId n12 = join(nodes[ne].sw, nodes[ne].se, nodes[se].nw, nodes[se].ne);
+            NodeId n20 = sw;
+            NodeId n21 = join(nodes[sw].ne, nodes[se].nw, nodes[sw].se, nodes[se].sw);
+            NodeId n22 = se;
+
+            // Full speed advances both halves in time; slower steps only the second half
+            bool fullSpeed = stepLog == nodes[id].level - 2;
+            NodeId r[9];
+            NodeId nine[9] = { n00, n01, n02, n10, n11, n12, n20, n21, n22 };
+            for (int i = 0; i < 9; i++) {
+                r[i] = fullSpeed ? advance(nine[i], stepLog - 1) : centre(nine[i]);
+            }
+
+            int secondLog = fullSpeed ? stepLog - 1 : stepLog;
+            NodeId rnw = advance(join(r[0], r[1], r[3], r[4]), secondLog);
+            NodeId rne = advance(join(r[1], r[2], r[4], r[5]), secondLog);
+            NodeId rsw = advance(join(r[3], r[4], r[6], r[7]), secondLog);
+            NodeId rse = advance(join(r[4], r[5], r[7], r[8]), secondLog);
+            result = join(rnw, rne, rsw, rse);
+        }
+
+        nodes[id].result = result;
+        nodes[id].resultLog = static_cast<int8_t>(stepLog);
+        return result;
+    }
+
+    // Advance the torus root by 2^stepLog generations (stepLog <= rootLevel - 1)
+    NodeId torusJump(NodeId torus, int stepLog) {
+        NodeId tiled = join(torus, torus, torus, torus);
+        NodeId shifted = advance(tiled, stepLog);
+        // The result starts half a torus in; swap quadrants to undo the shift
+        return join(nodes[shifted].se, nodes[shifted].sw, nodes[shifted].ne, nodes[shifted].nw);
+    }
+
+    NodeId build(const BitGrid& grid, int level, int row0, int col0) {
+        if (level == LEAF_LEVEL) {
+            uint64_t bits = 0;
+            for (int r = 0; r < 8; r++) {
+                uint64_t byte = (grid.row(row0 + r)[col0 >> 6] >> (col0 & 63)) & 0xFF;
+                bits |= byte << (r * 8);
+            }
+            return leaf(bits);
+        }
+        int half = 1 << (level - 1);
+        NodeId nw = build(grid, level - 1, row0, col0);
+        NodeId ne = build(grid, level - 1, row0, col0 + half);
+        NodeId sw = build(grid, level - 1, row0 + half, col0);
+        NodeId se = build(grid, level - 1, row0 + half, col0 + half);
+        return join(nw, ne, sw, se);
+    }
+
+    void store(NodeId id, BitGrid& grid, int row0, int col0) const {
+        const Node& node = nodes[id];
+        if (node.level == LEAF_LEVEL) {
+            for (int r = 0; r < 8; r++) {
+                uint64_t* word = &grid.row(row0 + r)[col0 >> 6];
+                *word &= ~(0xFFULL << (col0 & 63));
+                *word |= ((node.bits >> (r * 8)) & 0xFF) << (col0 & 63);
+            }
+            return;
+        }
+        int half = 1 << (node.level - 1);
+        store(node.nw, grid, row0, col0);
+        store(node.ne, grid, row0, col0 + half);
+        store(node.sw, grid, row0 + half, col0);
+        store(node.se, grid, row0 + half, col0 + half);
+    }
+
+    void mark(NodeId id) {
+        if (id == NONE || nodes[id].marked) return;
+        nodes[id].marked = true;
+        if (nodes[id].level > LEAF_LEVEL) {
+            mark(nodes[id].nw);
+            mark(nodes[id].ne);
+            mark(nodes[id].sw);
+            mark(nodes[id].se);
+        }
+    }
+
+public:
+    HashLife() : root(NONE), rootLevel(0), gcThreshold(1u << 22), conway(true) {}
+
+    // Rule for later steps; cached futures computed under the old rule are dropped
+    void setRule(const life::Rule& rule) {
+        conway = rule == life::CONWAY;
+        ruleTable = life::RuleTable(rule);
+        for (Node& node : nodes) {
+            node.resultLog = -1;
+        }
+    }
+
+    // HashLife needs a square torus whose side is a power of two, at least 16
+    static bool supportsTorus(int rows, int cols) {
+        return rows == cols && rows >= 16 && (rows & (rows - 1)) == 0;
+    }
+
+    // Replace the universe with the contents of a torus grid
+    void loadTorus(const BitGrid& grid) {
+        int level = 0;
+        while ((1 << level) < grid.getRows()) level++;
+        rootLevel = level;
+        root = build(grid, level, 0, 0);
+    }
+
+    // Write the universe back into a torus grid of the same size
+    void storeTorus(BitGrid& grid) const {
+        if (root != NONE) store(root, grid, 0, 0);
+    }
+
+    // Advance the torus by any number of generations. Large jumps are built
+    // from the biggest power-of-two steps the torus allows; since the torus is
+    // finite and nodes are canonical, a repeated root means the pattern has
+    // entered a cycle and the remaining full-size steps are skipped modulo it.
+    void stepTorus(uint64_t generations) {
+        if (root == NONE || generations == 0) return;
+        if (nodes.size() - freeList.size() > gcThreshold) collectGarbage();
+
+        int maxLog = rootLevel - 1;
+        uint64_t bigSteps = generations >> maxLog;
+        const size_t maxTracked = 1u << 20;
+        std::unordered_map<NodeId, uint64_t> seen;
+        bool cycleFound = false;
+
+        for (uint64_t i = 0; i < bigSteps; i++) {
+            if (!cycleFound && seen.size() < maxTracked) {
+                auto it = seen.find(root);
+                if (it != seen.end()) {
+                    uint64_t period = i - it->second;
+                    bigSteps = i + (bigSteps - i) % period;
+                    cycleFound = true;
+                    if (i >= bigSteps) break;
+                } else {
+                    seen.emplace(root, i);
+                }
+            }
+            root = torusJump(root, maxLog);
+
+            if (nodeCount() > gcThreshold) {
+                collectGarbage();
+                seen.clear();
+            }
+        }
+
+        for (int log = maxLog - 1; log >= 0; log--) {
+            if ((generations >> log) & 1ULL) {
+                root = torusJump(root, log);
+            }
+        }
+    }
+
+    // Advance the torus by exactly 2^log2Generations generations
+    void stepTorusPow2(int log2Generations) {
+        stepTorus(1ULL << log2Generations);
+    }
+
+    // Free every node not reachable from the current universe
+    void collectGarbage() {
+        for (Node& node : nodes) node.marked = false;
+        mark(root);
+
+        cache.clear();
+        freeList.clear();
+        for (NodeId id = 0; id < nodes.size(); id++) {
+            Node& node = nodes[id];
+            if (!node.marked) {
+                node.inUse = false;
+                node.resultLog = -1;
+                freeList.push_back(id);
+            }
+        }
+        for (NodeId id = 0; id < nodes.size(); id++) {
+            Node& node = nodes[id];
+            if (!node.inUse) continue;
+            if (node.result != NONE && !nodes[node.result].inUse) {
+                node.result = NONE;
+                node.resultLog = -1;
+            }
+            NodeKey key = node.level == LEAF_LEVEL ? leafKey(node.bits) : innerKey(node.nw, node.ne, node.sw, node.se);
+            cache.emplace(key, id);
+        }
+    }
+
+    // Live nodes currently held by the cache
+    size_t nodeCount() const { return nodes.size() - freeList.size(); }
+
+    void setGcThreshold(size_t liveNodes) { gcThreshold = liveNodes; }
+};
+
+#endif // LIFE_HASHLIFE_HPP
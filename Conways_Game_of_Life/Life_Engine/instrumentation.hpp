@@ -0,0 +1,217 @@
+// Per-generation timing samples of the engine, exported as CSV or a Chrome trace
+//
+// Each generation the engine times its phases with a PhaseClock and fills one
+// GenerationSample in place: nanoseconds per phase plus the population, the
+// cells that changed and the tiles recomputed. Samples live in a ring
+// allocated once when tracing is switched on, so recording allocates nothing
+// and takes no lock; the producer publishes each sample with a release store
+// of the sample count, and the ring keeps the newest `capacity` generations.
+// When tracing is off the engine holds no trace at all and pays one branch
+// per generation.
+//
+// The samples export as CSV (one row per generation) or as Chrome trace JSON
+// (chrome://tracing, Perfetto): one slice per phase on a single track, and
+// counter tracks for population, changed cells and active tiles.
+
+#ifndef LIFE_INSTRUMENTATION_HPP
+#define LIFE_INSTRUMENTATION_HPP
+
+#include "bit_grid.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace life {
+
+// Parts of a generation, in the order the engine runs them
+enum class TracePhase {
+    STEP,       // Neighbour counting and the rule; every kernel fuses the two
+    SWAP,       // Rotating the new generation into the history ring
+    STATS,      // Population count
+    DETECTION,  // Grid hash, cycle check and the Pattern Creation census
+    RECORD      // Timeline delta for stepping back
+};
+
+const int TRACE_PHASE_COUNT = 5;
+
+inline const char* tracePhaseName(TracePhase phase) {
+    switch (phase) {
+        case TracePhase::STEP: return "step";
+        case TracePhase::SWAP: return "swap";
+        case TracePhase::STATS: return "stats";
+        case TracePhase::DETECTION: return "detection";
+        case TracePhase::RECORD: return "record";
+        default: return "unknown";
+    }
+}
+
+struct GenerationSample {
+    int64_t generation;
+    int64_t startNs;                       // Since the trace was created
+    uint32_t phaseNs[TRACE_PHASE_COUNT];
+    int32_t population;
+    int32_t changedCells;                  // -1 if not known
+    int32_t activeTiles;                   // -1 if not known
+};
+
+// Splits the time since start into consecutive phases
+class PhaseClock {
+private:
+    std::chrono::steady_clock::time_point last;
+
+public:
+    PhaseClock() : last(std::chrono::steady_clock::now()) {}
+
+    // Nanoseconds since the previous lap (or construction)
+    uint32_t lap() {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count();
+        last = now;
+        return static_cast<uint32_t>(ns > 0xFFFFFFFFLL ? 0xFFFFFFFFLL : ns);
+    }
+};
+
+// Cells that differ between two grids of the same size
+inline int countChangedCells(const BitGrid& before, const BitGrid& after) {
+    int changed = 0;
+    const uint64_t* a = before.data();
+    const uint64_t* b = after.data();
+    for (std::size_t i = 0; i < before.wordCount(); i++) {
+        changed += __builtin_popcountll(a[i] ^ b[i]);
+    }
+    return changed;
+}
+
+} // namespace life
+
+class GenerationTrace {
+public:
+    static const std::size_t DEFAULT_CAPACITY = std::size_t(1) << 16;
+
+private:
+    std::vector<life::GenerationSample> samples;
+    std::atomic<uint64_t> written;  // Samples ever published; written by the producer only
+    std::chrono::steady_clock::time_point epoch;
+
+public:
+    explicit GenerationTrace(std::size_t capacity = DEFAULT_CAPACITY)
+        : samples(capacity > 0 ? capacity : 1), written(0), epoch(std::chrono::steady_clock::now()) {}
+
+    GenerationTrace(const GenerationTrace&) = delete;
+    GenerationTrace& operator=(const GenerationTrace&) = delete;
+
+    // Producer: the slot for a generation starting now, zeroed; publish it
+    // with commit() once filled
+    life::GenerationSample& begin(int64_t generation) {
+        life::GenerationSample& sample = samples[written.load(std::memory_order_relaxed) % samples.size()];
+        sample = life::GenerationSample();
+        sample.generation = generation;
+        sample.startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch).count();
+        sample.changedCells = -1;
+        sample.activeTiles = -1;
+        return sample;
+    }
+
+    void commit() {
+        written.store(written.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Samples held, oldest first; read them once the producer has stopped
+    std::size_t size() const {
+        uint64_t n = written.load(std::memory_order_acquire);
+        return static_cast<std::size_t>(n < samples.size() ? n : samples.size());
+    }
+
+    uint64_t getTotalSamples() const { return written.load(std::memory_order_acquire); }
+
+    const life::GenerationSample& at(std::size_t i) const {
+        uint64_t n = written.load(std::memory_order_acquire);
+        uint64_t first = n > samples.size() ? n - samples.size() : 0;
+        return samples[(first + i) % samples.size()];
+    }
+
+    // Total nanoseconds spent in phase over the samples held
+    uint64_t totalNs(life::TracePhase phase) const {
+        uint64_t total = 0;
+        for (std::size_t i = 0; i < size(); i++) {
+            total += at(i).phaseNs[static_cast<int>(phase)];
+        }
+        return total;
+    }
+
+    void writeCsv(std::ostream& out) const {
+        out << "generation,start_us";
+        for (int p = 0; p < life::TRACE_PHASE_COUNT; p++) {
+            out << "," << life::tracePhaseName(static_cast<life::TracePhase>(p)) << "_ns";
+        }
+        out << ",total_ns,population,changed_cells,active_tiles\n";
+        for (std::size_t i = 0; i < size(); i++) {
+            const life::GenerationSample& sample = at(i);
+            uint64_t total = 0;
+            out << sample.generation << "," << sample.startNs / 1000;
+            for (uint32_t ns : sample.phaseNs) {
+                out << "," << ns;
+                total += ns;
+            }
+            out << "," << total << "," << sample.population << "," << sample.changedCells << ","
+                << sample.activeTiles << "\n";
+        }
+    }
+
+    // Chrome trace event format; timestamps are microseconds
+    void writeChromeTrace(std::ostream& out) const {
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Life engine\"}}";
+        out << std::fixed << std::setprecision(3);
+        for (std::size_t i = 0; i < size(); i++) {
+            const life::GenerationSample& sample = at(i);
+            double start = sample.startNs / 1000.0;
+            double ts = start;
+            for (int p = 0; p < life::TRACE_PHASE_COUNT; p++) {
+                double duration = sample.phaseNs[p] / 1000.0;
+                out << ",\n{\"name\":\"" << life::tracePhaseName(static_cast<life::TracePhase>(p))
+                    << "\",\"cat\":\"generation\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << ts
+                    << ",\"dur\":" << duration << ",\"args\":{\"generation\":" << sample.generation << "}}";
+                ts += duration;
+            }
+            out << ",\n{\"name\":\"cells\",\"ph\":\"C\",\"pid\":1,\"ts\":" << start
+                << ",\"args\":{\"population\":" << sample.population;
+            if (sample.changedCells >= 0) out << ",\"changed\":" << sample.changedCells;
+            out << "}}";
+            if (sample.activeTiles >= 0) {
+                out << ",\n{\"name\":\"active tiles\",\"ph\":\"C\",\"pid\":1,\"ts\":" << start
+                    << ",\"args\":{\"tiles\":" << sample.activeTiles << "}}";
+            }
+        }
+        out << "\n]}\n";
+        out.unsetf(std::ios::floatfield);
+    }
+
+    // Write to path: CSV for a .csv name, else Chrome trace JSON
+    bool writeFile(const std::string& path, std::string& error) const {
+        std::ofstream file(path);
+        if (!file) {
+            error = "cannot create " + path;
+            return false;
+        }
+        bool csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+        if (csv) {
+            writeCsv(file);
+        } else {
+            writeChromeTrace(file);
+        }
+        if (!file) {
+            error = "cannot write " + path;
+            return false;
+        }
+        return true;
+    }
+};
+
+#endif // LIFE_INSTRUMENTATION_HPP
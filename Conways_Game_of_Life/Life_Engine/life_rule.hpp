@@ -0,0 +1,249 @@
+// Life-like (outer-totalistic) rules in B/S notation and their word kernels
+//
+// A rule is two 9-bit sets: the neighbour counts at which a dead cell is born
+// and those at which a live cell survives. "B3/S23" is Conway's Life,
+// "B36/S23" HighLife, "B3678/S34678" Day & Night.
+//
+// The packed kernels already sum the eight neighbours of 64 cells per word
+// into four bit-planes (s8 s4 s2 s1). A rule parsed at run time is compiled to
+// a RuleTable of all-zero/all-one words, one per count for birth and one for
+// survival, and the kernel ANDs each count's match mask with its table word:
+// every rule costs the same instructions and no cell ever branches on it.
+// Rules known at compile time instead use StaticRuleOp, whose unused counts
+// are discarded by if constexpr, and B3/S23 keeps its hand-reduced formula.
+
+#ifndef LIFE_LIFE_RULE_HPP
+#define LIFE_LIFE_RULE_HPP
+
+#include "bit_grid.hpp"
+#include <cstdint>
+#include <string>
+
+namespace life {
+
+struct Rule {
+    uint16_t birth;    // Bit n set: a dead cell with n live neighbours is born
+    uint16_t survive;  // Bit n set: a live cell with n live neighbours survives
+
+    bool operator==(const Rule& other) const { return birth == other.birth && survive == other.survive; }
+    bool operator!=(const Rule& other) const { return !(*this == other); }
+};
+
+constexpr uint16_t countMask(const char* digits) {
+    return *digits ? static_cast<uint16_t>((1u << (*digits - '0')) | countMask(digits + 1)) : 0;
+}
+
+const Rule CONWAY = { countMask("3"), countMask("23") };
+const Rule HIGHLIFE = { countMask("36"), countMask("23") };
+const Rule DAY_AND_NIGHT = { countMask("3678"), countMask("34678") };
+
+// Parse "B36/S23" (either case, either order) or the older "23/36" survive/birth
+// form. Returns false and sets error if the string is not a Life-like rule.
+inline bool parseRule(const std::string& text, Rule& rule, std::string& error) {
+    std::string::size_type slash = text.find('/');
+    if (slash == std::string::npos) {
+        error = "expected a rule like B3/S23";
+        return false;
+    }
+
+    uint16_t sets[2] = {0, 0};
+    char letters[2] = {0, 0};
+    std::string parts[2] = { text.substr(0, slash), text.substr(slash + 1) };
+    for (int p = 0; p < 2; p++) {
+        for (char c : parts[p]) {
+            if (c == 'B' || c == 'b' || c == 'S' || c == 's') {
+                if (letters[p] || sets[p]) {
+                    error = "misplaced '" + std::string(1, c) + "' in rule " + text;
+                    return false;
+                }
+                letters[p] = static_cast<char>(c == 'b' || c == 'B' ? 'B' : 'S');
+            } else if (c >= '0' && c <= '8') {
+                sets[p] = static_cast<uint16_t>(sets[p] | (1u << (c - '0')));
+            } else if (c != ' ') {
+                error = "unexpected '" + std::string(1, c) + "' in rule " + text;
+                return false;
+            }
+        }
+    }
+
+    if (!letters[0] && !letters[1]) {
+        rule = { sets[1], sets[0] };  // Survive/birth without letters
+    } else if (letters[0] == 'B' && letters[1] == 'S') {
+        rule = { sets[0], sets[1] };
+    } else if (letters[0] == 'S' && letters[1] == 'B') {
+        rule = { sets[1], sets[0] };
+    } else {
+        error = "rule " + text + " needs one B part and one S part";
+        return false;
+    }
+    return true;
+}
+
+inline std::string ruleString(const Rule& rule) {
+    std::string text = "B";
+    for (int n = 0; n <= 8; n++) {
+        if ((rule.birth >> n) & 1) text.push_back(static_cast<char>('0' + n));
+    }
+    text += "/S";
+    for (int n = 0; n <= 8; n++) {
+        if ((rule.survive >> n) & 1) text.push_back(static_cast<char>('0' + n));
+    }
+    return text;
+}
+
+// Display name of well-known rules, else the B/S string
+inline std::string ruleName(const Rule& rule) {
+    if (rule == CONWAY) return "Conway's Life (B3/S23)";
+    if (rule == HIGHLIFE) return "HighLife (B36/S23)";
+    if (rule == DAY_AND_NIGHT) return "Day & Night (B3678/S34678)";
+    return ruleString(rule);
+}
+
+// Whether empty space stays empty, which unbounded universes rely on (no B0)
+inline bool ruleKeepsVoid(const Rule& rule) {
+    return (rule.birth & 1u) == 0;
+}
+
+// Next state of one cell from its neighbour count; reference for the kernels
+inline bool ruleNextState(const Rule& rule, bool alive, int neighbors) {
+    return ((alive ? rule.survive : rule.birth) >> neighbors) & 1u;
+}
+
+// Sum the eight neighbours of 64 cells per lane into bit-planes s1 s2 s4 s8
+template <typename Lanes>
+LIFE_ALWAYS_INLINE void neighbourCount(const Lanes& aW, const Lanes& a, const Lanes& aE,
+                                       const Lanes& bW, const Lanes& bE,
+                                       const Lanes& cW, const Lanes& c, const Lanes& cE,
+                                       Lanes& s1, Lanes& s2, Lanes& s4, Lanes& s8) {
+    Lanes top1, top2, bot1, bot2, mid1, mid2;
+    fullAdd(aW, a, aE, top1, top2);
+    fullAdd(cW, c, cE, bot1, bot2);
+    halfAdd(bW, bE, mid1, mid2);
+
+    Lanes carry2;
+    fullAdd(top1, bot1, mid1, s1, carry2);
+
+    Lanes x2, x4, y4;
+    fullAdd(top2, bot2, mid2, x2, x4);
+    halfAdd(x2, carry2, s2, y4);
+    halfAdd(x4, y4, s4, s8);
+}
+
+// Lanes where the count equals n, from the planes and their complements
+template <typename Lanes>
+LIFE_ALWAYS_INLINE void countIs(int n, const Lanes& s1, const Lanes& s2, const Lanes& s4, const Lanes& s8,
+                                const Lanes& n1, const Lanes& n2, const Lanes& n4, const Lanes& n8, Lanes& match) {
+    if (n == 8) {
+        match = s8;  // Only a count of 8 sets s8, and it leaves the rest clear
+    } else {
+        match = ((n & 1) ? s1 : n1) & ((n & 2) ? s2 : n2) & ((n & 4) ? s4 : n4) & n8;
+    }
+}
+
+// B3/S23 with the original reduced formula
+struct ConwayOp {
+    template <typename Lanes>
+    LIFE_ALWAYS_INLINE void apply(const Lanes& aW, const Lanes& a, const Lanes& aE,
+                                  const Lanes& bW, const Lanes& b, const Lanes& bE,
+                                  const Lanes& cW, const Lanes& c, const Lanes& cE, Lanes& next) const {
+        conwayLanes(aW, a, aE, bW, b, bE, cW, c, cE, next);
+    }
+};
+
+// A rule fixed at compile time: counts outside Birth/Survive generate no code
+template <uint16_t Birth, uint16_t Survive>
+struct StaticRuleOp {
+    template <typename Lanes>
+    LIFE_ALWAYS_INLINE void apply(const Lanes& aW, const Lanes& a, const Lanes& aE,
+                                  const Lanes& bW, const Lanes& b, const Lanes& bE,
+                                  const Lanes& cW, const Lanes& c, const Lanes& cE, Lanes& next) const {
+        Lanes s1, s2, s4, s8;
+        neighbourCount(aW, a, aE, bW, bE, cW, c, cE, s1, s2, s4, s8);
+        Lanes n1 = ~s1, n2 = ~s2, n4 = ~s4, n8 = ~s8;
+        Lanes born = {};
+        Lanes kept = {};
+        addCounts<0>(s1, s2, s4, s8, n1, n2, n4, n8, born, kept);
+        next = (born & ~b) | (kept & b);
+    }
+
+private:
+    template <int N, typename Lanes>
+    LIFE_ALWAYS_INLINE static void addCounts(const Lanes& s1, const Lanes& s2, const Lanes& s4, const Lanes& s8,
+                                             const Lanes& n1, const Lanes& n2, const Lanes& n4, const Lanes& n8,
+                                             Lanes& born, Lanes& kept) {
+        if constexpr (N <= 8) {
+            if constexpr (((Birth | Survive) >> N) & 1) {
+                Lanes match;
+                countIs(N, s1, s2, s4, s8, n1, n2, n4, n8, match);
+                if constexpr ((Birth >> N) & 1) born = born | match;
+                if constexpr ((Survive >> N) & 1) kept = kept | match;
+            }
+            addCounts<N + 1>(s1, s2, s4, s8, n1, n2, n4, n8, born, kept);
+        }
+    }
+};
+
+using HighLifeOp = StaticRuleOp<countMask("36"), countMask("23")>;
+using DayAndNightOp = StaticRuleOp<countMask("3678"), countMask("34678")>;
+
+// A rule chosen at run time, compiled to one all-zero/all-one word per count
+struct RuleTable {
+    uint64_t birth[9];
+    uint64_t survive[9];
+
+    RuleTable() : RuleTable(CONWAY) {}
+    explicit RuleTable(const Rule& rule) {
+        for (int n = 0; n <= 8; n++) {
+            birth[n] = ((rule.birth >> n) & 1u) ? ~0ULL : 0;
+            survive[n] = ((rule.survive >> n) & 1u) ? ~0ULL : 0;
+        }
+    }
+};
+
+struct TableRuleOp {
+    const RuleTable& table;
+
+    explicit TableRuleOp(const RuleTable& ruleTable) : table(ruleTable) {}
+
+    template <typename Lanes>
+    LIFE_ALWAYS_INLINE void apply(const Lanes& aW, const Lanes& a, const Lanes& aE,
+                                  const Lanes& bW, const Lanes& b, const Lanes& bE,
+                                  const Lanes& cW, const Lanes& c, const Lanes& cE, Lanes& next) const {
+        Lanes s1, s2, s4, s8;
+        neighbourCount(aW, a, aE, bW, bE, cW, c, cE, s1, s2, s4, s8);
+        Lanes n1 = ~s1, n2 = ~s2, n4 = ~s4, n8 = ~s8;
+        Lanes born = {};
+        Lanes kept = {};
+        for (int n = 0; n <= 8; n++) {
+            Lanes match;
+            countIs(n, s1, s2, s4, s8, n1, n2, n4, n8, match);
+            born = born | (match & table.birth[n]);
+            kept = kept | (match & table.survive[n]);
+        }
+        next = (born & ~b) | (kept & b);
+    }
+};
+
+// Next state of one word under op; the rule-generic counterpart of stepWord
+template <typename Op>
+inline uint64_t stepWordWith(const Op& op, const BitGrid& grid, const uint64_t* above, const uint64_t* here,
+                             const uint64_t* below, int w) {
+    uint64_t next;
+    op.apply(westOf(above, w, grid), above[w], eastOf(above, w, grid),
+             westOf(here, w, grid), here[w], eastOf(here, w, grid),
+             westOf(below, w, grid), below[w], eastOf(below, w, grid), next);
+    return next;
+}
+
+// One word of any rule from pre-shifted neighbour rows, for kernels outside the torus grid
+inline uint64_t ruleWord(const RuleTable& table, uint64_t aW, uint64_t a, uint64_t aE,
+                         uint64_t bW, uint64_t b, uint64_t bE,
+                         uint64_t cW, uint64_t c, uint64_t cE) {
+    uint64_t next;
+    TableRuleOp(table).apply<uint64_t>(aW, a, aE, bW, b, bE, cW, c, cE, next);
+    return next;
+}
+
+} // namespace life
+
+#endif // LIFE_LIFE_RULE_HPP
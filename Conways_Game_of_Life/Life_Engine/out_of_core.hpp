@@ -0,0 +1,469 @@
+// Out-of-core stepping of boards larger than memory, through mapped row bands
+//
+// The board lives in a raw snapshot file (every band RAW, see snapshot.hpp),
+// which is the grid's own memory image behind a header: a file written here
+// loads like any other .snap, and a raw .snap can be run here. Both the
+// current and the next generation are files mapped shared, so the page cache
+// rather than the heap holds them, and only one band is ever resident in
+// process memory.
+//
+// A pass streams through the board one band of rows at a time. The band and
+// `depth` halo rows above and below it (wrapping, as the board is a torus) are
+// copied out of the mapping into a scratch grid, advanced `depth` generations
+// there with the SIMD kernels across the thread pool, and its interior is
+// written to the output mapping. As in temporal_blocking.hpp the halo rows go
+// stale one row per generation and are thrown away, so one pass over the disk
+// covers `depth` generations. Both files are ping-ponged between passes.
+//
+// The mappings are hinted for a sequential scan: the input band after the
+// current one is requested ahead of time (MADV_WILLNEED), and input rows no
+// later band needs and output bands already written are released
+// (MADV_DONTNEED), so resident memory stays at a few bands however large the
+// board. The output checksum is accumulated as bands are written.
+//
+// Memory mapping is POSIX only; on Windows opening a board reports an error.
+
+#ifndef LIFE_OUT_OF_CORE_HPP
+#define LIFE_OUT_OF_CORE_HPP
+
+#include "parallel_step.hpp"
+#include "snapshot.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// A raw snapshot file mapped for reading or writing in place
+class MappedBoardFile {
+private:
+    unsigned char* base;
+    std::size_t size;
+    bool writable;
+    std::size_t wordsPerRow;
+
+    life::SnapshotHeader& header() const { return *reinterpret_cast<life::SnapshotHeader*>(base); }
+    life::SnapshotBand* bands() const {
+        return reinterpret_cast<life::SnapshotBand*>(base + sizeof(life::SnapshotHeader));
+    }
+
+    static std::size_t pageSize() {
+#if defined(_WIN32)
+        return 4096;
+#else
+        static const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return page;
+#endif
+    }
+
+    bool map(int fd, std::size_t bytes, std::string& error) {
+#if defined(_WIN32)
+        (void)fd;
+        (void)bytes;
+        error = "out-of-core boards need memory mapping, which this build does not support";
+        return false;
+#else
+        void* mapping = mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            error = "cannot map the board file";
+            return false;
+        }
+        base = static_cast<unsigned char*>(mapping);
+        size = bytes;
+        return true;
+#endif
+    }
+
+    // Pass advice for rows [firstRow, lastRow) to the kernel, widened to whole pages
+    void advise(int firstRow, int lastRow, int advice) const {
+#if defined(_WIN32)
+        (void)firstRow;
+        (void)lastRow;
+        (void)advice;
+#else
+        if (!base || firstRow >= lastRow) {
+            return;
+        }
+        std::size_t begin = reinterpret_cast<const unsigned char*>(row(firstRow)) - base;
+        std::size_t end = reinterpret_cast<const unsigned char*>(row(lastRow - 1) + wordsPerRow) - base;
+        begin -= begin % pageSize();
+        madvise(base + begin, end - begin, advice);
+#endif
+    }
+
+public:
+    MappedBoardFile() : base(nullptr), size(0), writable(false), wordsPerRow(0) {}
+    ~MappedBoardFile() { close(); }
+
+    MappedBoardFile(const MappedBoardFile&) = delete;
+    MappedBoardFile& operator=(const MappedBoardFile&) = delete;
+
+    // Create path as an empty rows x cols board; the file is sized but sparse,
+    // so nothing is written until rows are
+    bool create(const std::string& path, int rows, int cols, const life::SnapshotInfo& info, std::string& error) {
+        close();
+        if (rows <= 0 || cols <= 0) {
+            error = "board dimensions must be positive";
+            return false;
+        }
+        life::SnapshotHeader fresh;
+        std::memset(&fresh, 0, sizeof(fresh));
+        std::memcpy(fresh.magic, life::SNAPSHOT_MAGIC, sizeof(fresh.magic));
+        fresh.version = life::SNAPSHOT_VERSION;
+        fresh.byteOrder = life::SNAPSHOT_BYTE_ORDER;
+        fresh.rows = rows;
+        fresh.cols = cols;
+        fresh.generation = info.generation;
+        fresh.originRow = info.originRow;
+        fresh.originCol = info.originCol;
+        fresh.checksum = 0;  // hashGrid of an empty board
+        fresh.bandRows = life::SNAPSHOT_BAND_ROWS;
+        fresh.bandCount = static_cast<uint32_t>((rows + life::SNAPSHOT_BAND_ROWS - 1) / life::SNAPSHOT_BAND_ROWS);
+        std::strncpy(fresh.rule, info.rule.c_str(), sizeof(fresh.rule) - 1);
+
+        // Cells start on a page boundary after the header and band table
+        std::size_t rowBytes = static_cast<std::size_t>((cols + 63) / 64) * sizeof(uint64_t);
+        std::size_t tableBytes = sizeof(fresh) + fresh.bandCount * sizeof(life::SnapshotBand);
+        std::size_t cellsOffset = (tableBytes + pageSize() - 1) / pageSize() * pageSize();
+        std::vector<life::SnapshotBand> table(fresh.bandCount);
+        for (uint32_t b = 0; b < fresh.bandCount; b++) {
+            int bandRows = std::min(life::SNAPSHOT_BAND_ROWS, rows - static_cast<int>(b) * life::SNAPSHOT_BAND_ROWS);
+            table[b].offset = cellsOffset + static_cast<uint64_t>(b) * life::SNAPSHOT_BAND_ROWS * rowBytes;
+            table[b].bytes = static_cast<uint64_t>(bandRows) * rowBytes;
+            table[b].encoding = static_cast<uint32_t>(life::BandEncoding::RAW);
+        }
+        std::size_t bytes = cellsOffset + static_cast<std::size_t>(rows) * rowBytes;
+
+#if defined(_WIN32)
+        error = "out-of-core boards need memory mapping, which this build does not support";
+        (void)path;
+        (void)bytes;
+        return false;
+#else
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            error = "cannot open " + path + " for writing";
+            return false;
+        }
+        bool sized = ftruncate(fd, static_cast<off_t>(bytes)) == 0 &&
+                     pwrite(fd, &fresh, sizeof(fresh), 0) == static_cast<ssize_t>(sizeof(fresh)) &&
+                     pwrite(fd, table.data(), table.size() * sizeof(life::SnapshotBand), sizeof(fresh)) ==
+                         static_cast<ssize_t>(table.size() * sizeof(life::SnapshotBand));
+        if (!sized) {
+            error = "failed writing " + path;
+        }
+        writable = true;
+        bool ok = sized && map(fd, bytes, error);
+        ::close(fd);
+        if (!ok) {
+            close();
+            return false;
+        }
+        wordsPerRow = (cols + 63) / 64;
+        return true;
+#endif
+    }
+
+    // Map an existing snapshot, which must be raw throughout
+    bool open(const std::string& path, bool forWriting, std::string& error) {
+        close();
+#if defined(_WIN32)
+        (void)path;
+        (void)forWriting;
+        error = "out-of-core boards need memory mapping, which this build does not support";
+        return false;
+#else
+        int fd = ::open(path.c_str(), forWriting ? O_RDWR : O_RDONLY);
+        if (fd < 0) {
+            error = "cannot open " + path;
+            return false;
+        }
+        off_t bytes = lseek(fd, 0, SEEK_END);
+        bool large = bytes >= static_cast<off_t>(sizeof(life::SnapshotHeader));
+        if (!large) {
+            error = "not a Life snapshot";
+        }
+        writable = forWriting;
+        bool ok = large && map(fd, static_cast<std::size_t>(bytes), error);
+        ::close(fd);
+        if (!ok) {
+            close();
+            return false;
+        }
+
+        const life::SnapshotHeader& h = header();
+        if (std::memcmp(h.magic, life::SNAPSHOT_MAGIC, sizeof(h.magic)) != 0 ||
+            h.version != life::SNAPSHOT_VERSION || h.byteOrder != life::SNAPSHOT_BYTE_ORDER) {
+            error = "not a Life snapshot of this version and byte order";
+            close();
+            return false;
+        }
+        wordsPerRow = (static_cast<std::size_t>(h.cols) + 63) / 64;
+        ok = h.rows > 0 && h.cols > 0 && h.bandRows > 0 &&
+             h.bandCount == (static_cast<uint64_t>(h.rows) + h.bandRows - 1) / h.bandRows &&
+             size >= sizeof(h) + static_cast<uint64_t>(h.bandCount) * sizeof(life::SnapshotBand);
+        for (uint32_t b = 0; ok && b < h.bandCount; b++) {
+            const life::SnapshotBand& band = bands()[b];
+            uint64_t rowsInBand = std::min<uint64_t>(h.bandRows, static_cast<uint64_t>(h.rows) - b * h.bandRows);
+            ok = band.encoding == static_cast<uint32_t>(life::BandEncoding::RAW) && band.offset % sizeof(uint64_t) == 0 &&
+                 band.bytes == rowsInBand * wordsPerRow * sizeof(uint64_t) && band.offset <= size &&
+                 band.bytes <= size - band.offset;
+        }
+        if (!ok) {
+            error = "snapshot is corrupt or has zero-run coded bands (save it uncompressed to run it out of core)";
+            close();
+            return false;
+        }
+        return true;
+#endif
+    }
+
+    // Flush written rows to the file and unmap it
+    void close() {
+#if !defined(_WIN32)
+        if (base) {
+            if (writable) {
+                msync(base, size, MS_SYNC);
+            }
+            munmap(base, size);
+        }
+#endif
+        base = nullptr;
+        size = 0;
+    }
+
+    bool isOpen() const { return base != nullptr; }
+    int getRows() const { return header().rows; }
+    int getCols() const { return header().cols; }
+    int getWordsPerRow() const { return static_cast<int>(wordsPerRow); }
+    uint64_t getChecksum() const { return header().checksum; }
+
+    life::SnapshotInfo getInfo() const {
+        life::SnapshotInfo info;
+        info.generation = header().generation;
+        info.originRow = header().originRow;
+        info.originCol = header().originCol;
+        info.rule = std::string(header().rule, strnlen(header().rule, sizeof(header().rule)));
+        return info;
+    }
+
+    // Header fields of a board opened for writing
+    void setGeneration(long long generation) { header().generation = generation; }
+    void setChecksum(uint64_t checksum) { header().checksum = checksum; }
+    void setRule(const std::string& rule) {
+        std::memset(header().rule, 0, sizeof(header().rule));
+        std::strncpy(header().rule, rule.c_str(), sizeof(header().rule) - 1);
+    }
+
+    const uint64_t* row(int r) const {
+        int b = r / static_cast<int>(header().bandRows);
+        int rowInBand = r - b * static_cast<int>(header().bandRows);
+        return reinterpret_cast<const uint64_t*>(base + bands()[b].offset) +
+               static_cast<std::size_t>(rowInBand) * wordsPerRow;
+    }
+    uint64_t* row(int r) { return const_cast<uint64_t*>(static_cast<const MappedBoardFile&>(*this).row(r)); }
+
+    // Access pattern hints for rows [firstRow, lastRow)
+    void adviseSequential() const {
+#if !defined(_WIN32)
+        if (base) madvise(base, size, MADV_SEQUENTIAL);
+#endif
+    }
+    void willNeed(int firstRow, int lastRow) const {
+#if !defined(_WIN32)
+        advise(firstRow, lastRow, MADV_WILLNEED);
+#else
+        advise(firstRow, lastRow, 0);
+#endif
+    }
+    void dontNeed(int firstRow, int lastRow) const {
+#if !defined(_WIN32)
+        advise(firstRow, lastRow, MADV_DONTNEED);
+#else
+        advise(firstRow, lastRow, 0);
+#endif
+    }
+};
+
+class OutOfCoreStepper {
+public:
+    static const int DEFAULT_DEPTH = 8;                              // Generations per pass
+    static const std::size_t DEFAULT_BAND_BYTES = std::size_t(64) << 20;  // Cells per band, halo excluded
+
+    // Called after every pass with the generations done so far
+    using Progress = std::function<void(long long done, long long total)>;
+
+private:
+    int depth;
+    std::size_t bandBytes;
+    BitGrid scratch;
+    BitGrid scratchNext;
+
+    // Advance input by generations into output, which has the same dimensions
+    uint64_t pass(const MappedBoardFile& input, MappedBoardFile& output, int generations, ThreadPool& pool,
+                  const life::RuleKernel& kernel) {
+        const int rows = input.getRows();
+        const int cols = input.getCols();
+        const std::size_t rowBytes = static_cast<std::size_t>(input.getWordsPerRow()) * sizeof(uint64_t);
+        const int bandRows = static_cast<int>(std::max<std::size_t>(1, std::min<std::size_t>(bandBytes / rowBytes, rows)));
+        const int height = bandRows + 2 * generations;
+        if (scratch.getRows() != height || scratch.getCols() != cols) {
+            scratch = BitGrid(height, cols);
+            scratchNext = BitGrid(height, cols);
+        }
+
+        input.adviseSequential();
+        output.adviseSequential();
+        uint64_t checksum = 0;
+        for (int first = 0; first < rows; first += bandRows) {
+            int last = std::min(rows, first + bandRows);
+            int next = std::min(rows, last + bandRows);
+            input.willNeed(last, std::min(rows, next + generations));
+
+            // The band and its halo, wrapping around the torus; a short last
+            // band leaves the bottom of the scratch grid stale, which only
+            // reaches rows past the ones kept
+            int loaded = last - first + 2 * generations;
+            for (int i = 0; i < loaded; i++) {
+                int r = static_cast<int>(((static_cast<long long>(first) - generations + i) % rows + rows) % rows);
+                std::memcpy(scratch.row(i), input.row(r), rowBytes);
+            }
+            if (loaded < height) {
+                std::memset(scratch.row(loaded), 0, (height - loaded) * rowBytes);
+            }
+            for (int g = 0; g < generations; g++) {
+                life::stepParallel(scratch, scratchNext, pool, kernel);
+                std::swap(scratch, scratchNext);
+            }
+
+            for (int r = first; r < last; r++) {
+                const uint64_t* from = scratch.row(generations + r - first);
+                uint64_t* to = output.row(r);
+                std::memcpy(to, from, rowBytes);
+                std::size_t index = static_cast<std::size_t>(r) * input.getWordsPerRow();
+                for (int w = 0; w < input.getWordsPerRow(); w++) {
+                    checksum ^= life::hashWord(from[w], index + w);
+                }
+            }
+            output.dontNeed(first, last);
+            // The rows above this band's halo are done with; the top rows are
+            // still the last band's halo
+            input.dontNeed(std::max(generations, first - generations - bandRows), first - generations);
+        }
+        return checksum;
+    }
+
+public:
+    OutOfCoreStepper(int generationsPerPass = DEFAULT_DEPTH, std::size_t maxBandBytes = DEFAULT_BAND_BYTES)
+        : depth(std::max(1, generationsPerPass)), bandBytes(std::max<std::size_t>(maxBandBytes, 1)) {}
+
+    // Run the board in inputPath for generations, leaving the result in
+    // outputPath (a raw snapshot) and the input untouched. A spare file beside
+    // the output holds alternate passes and is removed afterwards.
+    bool run(const std::string& inputPath, const std::string& outputPath, long long generations,
+             ThreadPool& pool, const life::Rule& rule, std::string& error, const Progress& progress = Progress()) {
+        MappedBoardFile source;
+        if (inputPath == outputPath) {
+            error = "the output must be a different file from the input";
+            return false;
+        }
+        if (!source.open(inputPath, false, error)) {
+            return false;
+        }
+        life::SnapshotInfo info = source.getInfo();
+        const life::RuleKernel kernel = life::fastRuleKernel(rule);
+        const std::string sparePath = outputPath + ".pass";
+
+        // The last pass must land in outputPath
+        long long passes = (generations + depth - 1) / depth;
+        std::string targets[2] = { passes % 2 == 1 ? outputPath : sparePath, passes % 2 == 1 ? sparePath : outputPath };
+        MappedBoardFile boards[2];
+        const MappedBoardFile* current = &source;
+        long long done = 0;
+        for (long long p = 0; p < passes; p++) {
+            MappedBoardFile& target = boards[p % 2];
+            if (!target.isOpen() && !target.create(targets[p % 2], source.getRows(), source.getCols(), info, error)) {
+                return false;
+            }
+            int step = static_cast<int>(std::min<long long>(depth, generations - done));
+            uint64_t checksum = pass(*current, target, step, pool, kernel);
+            done += step;
+            target.setGeneration(info.generation + done);
+            target.setChecksum(checksum);
+            target.setRule(life::ruleString(rule));
+            current = &target;
+            if (progress) {
+                progress(done, generations);
+            }
+        }
+
+        if (passes == 0) {
+            // Nothing to step: copy the board as it is
+            MappedBoardFile& target = boards[0];
+            if (!target.create(outputPath, source.getRows(), source.getCols(), info, error)) {
+                return false;
+            }
+            for (int r = 0; r < source.getRows(); r++) {
+                std::memcpy(target.row(r), source.row(r), source.getWordsPerRow() * sizeof(uint64_t));
+            }
+            target.setChecksum(source.getChecksum());
+        }
+        boards[0].close();
+        boards[1].close();
+        if (passes > 1) {
+            std::remove(sparePath.c_str());
+        }
+        return true;
+    }
+
+    // Write a random soup of the given size straight to path, band by band,
+    // as a starting board for run(); cell (r, c) depends only on seed and r
+    static bool createSoup(const std::string& path, int rows, int cols, double density, uint64_t seed,
+                           const life::Rule& rule, std::string& error) {
+        life::SnapshotInfo info;
+        info.rule = life::ruleString(rule);
+        MappedBoardFile board;
+        if (!board.create(path, rows, cols, info, error)) {
+            return false;
+        }
+        board.adviseSequential();
+        const int wordsPerRow = board.getWordsPerRow();
+        const uint64_t lastMask = cols % 64 == 0 ? ~0ULL : (1ULL << (cols % 64)) - 1;
+        // Each draw decides four cells, 16 random bits apiece
+        const uint64_t threshold = static_cast<uint64_t>(std::max(0.0, std::min(1.0, density)) * 65536.0);
+        uint64_t checksum = 0;
+        for (int r = 0; r < rows; r++) {
+            std::seed_seq sequence{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32), static_cast<uint32_t>(r)};
+            std::mt19937_64 random(sequence);
+            uint64_t* words = board.row(r);
+            for (int w = 0; w < wordsPerRow; w++) {
+                uint64_t word = 0;
+                for (int bit = 0; bit < 64; bit += 4) {
+                    uint64_t draw = random();
+                    for (int k = 0; k < 4; k++) {
+                        word |= static_cast<uint64_t>(((draw >> (16 * k)) & 0xFFFF) < threshold) << (bit + k);
+                    }
+                }
+                words[w] = w == wordsPerRow - 1 ? word & lastMask : word;
+                checksum ^= life::hashWord(words[w], static_cast<std::size_t>(r) * wordsPerRow + w);
+            }
+            if ((r + 1) % life::SNAPSHOT_BAND_ROWS == 0) {
+                board.dontNeed(r + 1 - life::SNAPSHOT_BAND_ROWS, r + 1);
+            }
+        }
+        board.setChecksum(checksum);
+        return true;
+    }
+};
+
+#endif // LIFE_OUT_OF_CORE_HPP
@@ -0,0 +1,68 @@
+// Multithreaded generation step for the bit-packed Life grid
+//
+// The torus is cut into row bands (and word columns when there are fewer rows
+// than tasks). Every task reads the shared, unmodified current generation and
+// writes only its own rectangle of the next one, so the halo rows and the
+// periodic wraparound at the board edges come straight from the source grid
+// with no copying or locking. Each output word is a pure function of the
+// source, which keeps the result identical for any thread count or schedule.
+
+#ifndef LIFE_PARALLEL_STEP_HPP
+#define LIFE_PARALLEL_STEP_HPP
+
+#include "simd_kernels.hpp"
+#include "thread_pool.hpp"
+#include <cstddef>
+
+namespace life {
+
+// Boards smaller than this (in words) are stepped on the calling thread,
+// since waking the workers would cost more than the generation itself
+const std::size_t PARALLEL_MIN_WORDS = 4096;
+
+// Tasks handed out per thread, so a slow core does not hold up the rest
+const int TASKS_PER_THREAD = 4;
+
+// Compute rows [rowBegin, rowEnd), words [wordBegin, wordEnd) of the next
+// generation under any rule, split across the pool's threads
+inline void stepRegionParallel(const BitGrid& current, BitGrid& next, ThreadPool& pool, const RuleKernel& kernel,
+                               int rowBegin, int rowEnd, int wordBegin, int wordEnd) {
+    if (rowBegin >= rowEnd || wordBegin >= wordEnd) {
+        return;
+    }
+    long long rows = rowEnd - rowBegin;
+    long long words = wordEnd - wordBegin;
+    if (pool.getThreadCount() == 1 || static_cast<std::size_t>(rows * words) < PARALLEL_MIN_WORDS) {
+        kernel(current, next, rowBegin, rowEnd, wordBegin, wordEnd);
+        return;
+    }
+
+    long long wanted = static_cast<long long>(pool.getThreadCount()) * TASKS_PER_THREAD;
+    long long bands = rows < wanted ? rows : wanted;
+    long long chunks = wanted / bands;
+    if (chunks > words) chunks = words;
+    if (chunks < 1) chunks = 1;
+
+    pool.parallelFor(static_cast<int>(bands * chunks), [&](int task, int) {
+        long long band = task / chunks;
+        long long chunk = task % chunks;
+        kernel(current, next,
+               rowBegin + static_cast<int>(rows * band / bands), rowBegin + static_cast<int>(rows * (band + 1) / bands),
+               wordBegin + static_cast<int>(words * chunk / chunks), wordBegin + static_cast<int>(words * (chunk + 1) / chunks));
+    });
+}
+
+// Compute the whole next generation under any rule, split across the pool's threads
+inline void stepParallel(const BitGrid& current, BitGrid& next, ThreadPool& pool, const RuleKernel& kernel) {
+    stepRegionParallel(current, next, pool, kernel, 0, current.getRows(), 0, current.getWordsPerRow());
+}
+
+// Compute the whole next generation of Conway's Life, split across the pool's threads
+inline void stepParallel(const BitGrid& current, BitGrid& next, ThreadPool& pool) {
+    static const RuleKernel conway = fastRuleKernel(CONWAY);
+    stepParallel(current, next, pool, conway);
+}
+
+} // namespace life
+
+#endif // LIFE_PARALLEL_STEP_HPP
@@ -0,0 +1,405 @@
+// Streaming import and export of Life patterns in RLE and Life 1.06 format
+//
+// Readers pull characters straight from the stream buffer and hand every
+// horizontal run of live cells to a sink as soon as it is decoded, so a
+// multi-megabyte RLE file never exists as a text grid or cell matrix in
+// memory. Writers are fed runs in row-major order and emit them the same way.
+//
+// RLE follows the format written by Golly: an optional "#CXRLE Pos=x,y" line,
+// other "#" comment lines, a header "x = W, y = H, rule = B3/S23", then runs
+// of b (dead), o (alive) and $ (end of row) terminated by '!'. Multi-state
+// letters are read as alive. Life 1.06 is "#Life 1.06" followed by one
+// "x y" coordinate pair per live cell.
+
+#ifndef LIFE_PATTERN_IO_HPP
+#define LIFE_PATTERN_IO_HPP
+
+#include "bit_grid.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace life {
+
+enum class PatternFormat {
+    RLE,
+    LIFE_106
+};
+
+// What the reader learned about a pattern besides its cells
+struct PatternInfo {
+    PatternFormat format = PatternFormat::RLE;
+    long long width = 0;        // From the RLE header, or the extent of a Life 1.06 file
+    long long height = 0;
+    long long originRow = 0;    // Top-left position from "#CXRLE Pos=", or the Life 1.06 minimum
+    long long originCol = 0;
+    long long liveCells = 0;
+    std::string rule = "B3/S23";
+};
+
+// Receives one horizontal run of live cells, relative to the pattern origin
+using RunSink = std::function<void(long long row, long long col, long long length)>;
+
+// Pattern format implied by a file name, defaulting to RLE
+inline PatternFormat patternFormatFor(const std::string& filename) {
+    std::string::size_type dot = filename.rfind('.');
+    std::string ext = dot == std::string::npos ? "" : filename.substr(dot + 1);
+    for (char& c : ext) {
+        c = static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+    }
+    return (ext == "lif" || ext == "life" || ext == "06") ? PatternFormat::LIFE_106 : PatternFormat::RLE;
+}
+
+// Whether a file name has a pattern extension the readers understand
+inline bool isPatternFile(const std::string& filename) {
+    std::string::size_type dot = filename.rfind('.');
+    if (dot == std::string::npos) return false;
+    std::string ext = filename.substr(dot + 1);
+    for (char& c : ext) {
+        c = static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+    }
+    return ext == "rle" || ext == "lif" || ext == "life" || ext == "06";
+}
+
+// Character source over a stream buffer that tracks the line for error messages
+class PatternScanner {
+private:
+    std::streambuf* buffer;
+    int line;
+
+public:
+    explicit PatternScanner(std::istream& in) : buffer(in.rdbuf()), line(1) {}
+
+    int peek() { return buffer->sgetc(); }
+
+    int next() {
+        int c = buffer->sbumpc();
+        if (c == '\n') line++;
+        return c;
+    }
+
+    int getLine() const { return line; }
+
+    // Read up to and including the end of the current line
+    std::string readLine() {
+        std::string text;
+        int c;
+        while ((c = next()) != std::char_traits<char>::eof() && c != '\n') {
+            if (c != '\r') text.push_back(static_cast<char>(c));
+        }
+        return text;
+    }
+
+    void skipSpaces() {
+        int c;
+        while ((c = peek()) == ' ' || c == '\t' || c == '\r') next();
+    }
+
+    // Optionally signed decimal integer; false if none is present
+    bool readInteger(long long& value) {
+        skipSpaces();
+        bool negative = false;
+        if (peek() == '-' || peek() == '+') {
+            negative = next() == '-';
+        }
+        if (peek() < '0' || peek() > '9') {
+            return false;
+        }
+        value = 0;
+        while (peek() >= '0' && peek() <= '9') {
+            value = value * 10 + (next() - '0');
+        }
+        if (negative) value = -value;
+        return true;
+    }
+};
+
+// Parse "x = 3, y = 3, rule = B3/S23" into info; unknown keys are ignored
+inline void parseRleHeader(const std::string& header, PatternInfo& info) {
+    std::string::size_type pos = 0;
+    while (pos < header.size()) {
+        std::string::size_type comma = header.find(',', pos);
+        std::string field = header.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        pos = comma == std::string::npos ? header.size() : comma + 1;
+
+        std::string::size_type equals = field.find('=');
+        if (equals == std::string::npos) continue;
+        std::string key, value;
+        for (char c : field.substr(0, equals)) {
+            if (c != ' ' && c != '\t') key.push_back(c);
+        }
+        for (char c : field.substr(equals + 1)) {
+            if (c != ' ' && c != '\t' && c != '\r') value.push_back(c);
+        }
+
+        if (key == "x") {
+            info.width = std::atoll(value.c_str());
+        } else if (key == "y") {
+            info.height = std::atoll(value.c_str());
+        } else if (key == "rule") {
+            info.rule = value;
+        }
+    }
+}
+
+// Stream an RLE pattern into sink. Returns false and sets error on malformed input.
+inline bool readRle(std::istream& in, const RunSink& sink, PatternInfo& info, std::string& error) {
+    PatternScanner scan(in);
+    const int eof = std::char_traits<char>::eof();
+    info.format = PatternFormat::RLE;
+
+    // Comment lines and the header
+    for (;;) {
+        scan.skipSpaces();
+        int c = scan.peek();
+        if (c == eof) {
+            error = "missing RLE header";
+            return false;
+        }
+        if (c == '\n') {
+            scan.next();
+        } else if (c == '#') {
+            std::string comment = scan.readLine();
+            std::string::size_type pos = comment.find("Pos=");
+            if (comment.compare(0, 6, "#CXRLE") == 0 && pos != std::string::npos) {
+                std::string coords = comment.substr(pos + 4);
+                info.originCol = std::atoll(coords.c_str());
+                std::string::size_type comma = coords.find(',');
+                if (comma != std::string::npos) {
+                    info.originRow = std::atoll(coords.c_str() + comma + 1);
+                }
+            }
+        } else if (c == 'x') {
+            parseRleHeader(scan.readLine(), info);
+            break;
+        } else {
+            break;  // Headerless data
+        }
+    }
+
+    long long row = 0;
+    long long col = 0;
+    long long count = 0;
+    for (;;) {
+        int c = scan.next();
+        if (c == eof || c == '!') {
+            return true;
+        }
+        if (c >= '0' && c <= '9') {
+            count = count * 10 + (c - '0');
+            continue;
+        }
+        long long run = count == 0 ? 1 : count;
+        if (c == 'b' || c == '.') {
+            col += run;
+        } else if (c == 'o' || (c >= 'A' && c <= 'X')) {
+            sink(row, col, run);
+            info.liveCells += run;
+            col += run;
+        } else if (c == '$') {
+            row += run;
+            col = 0;
+        } else if (c >= 'p' && c <= 'y') {
+            continue;  // Multi-state prefix; the following letter carries the state
+        } else if (c == '#') {
+            scan.readLine();  // Comments are tolerated between data lines
+        } else if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+            error = "unexpected '" + std::string(1, static_cast<char>(c)) + "' on line " + std::to_string(scan.getLine());
+            return false;
+        }
+        count = 0;
+    }
+}
+
+// Stream a Life 1.06 pattern into sink, one cell per run
+inline bool readLife106(std::istream& in, const RunSink& sink, PatternInfo& info, std::string& error) {
+    PatternScanner scan(in);
+    const int eof = std::char_traits<char>::eof();
+    info.format = PatternFormat::LIFE_106;
+
+    long long minRow = 0, minCol = 0, maxRow = -1, maxCol = -1;
+    for (;;) {
+        scan.skipSpaces();
+        int c = scan.peek();
+        if (c == eof) break;
+        if (c == '\n') {
+            scan.next();
+            continue;
+        }
+        if (c == '#') {
+            scan.readLine();
+            continue;
+        }
+
+        long long x, y;
+        if (!scan.readInteger(x) || !scan.readInteger(y)) {
+            error = "expected \"x y\" on line " + std::to_string(scan.getLine());
+            return false;
+        }
+        sink(y, x, 1);
+        if (info.liveCells == 0) {
+            minRow = maxRow = y;
+            minCol = maxCol = x;
+        } else {
+            if (y < minRow) minRow = y;
+            if (y > maxRow) maxRow = y;
+            if (x < minCol) minCol = x;
+            if (x > maxCol) maxCol = x;
+        }
+        info.liveCells++;
+        scan.readLine();
+    }
+
+    info.originRow = minRow;
+    info.originCol = minCol;
+    info.height = maxRow - minRow + 1;
+    info.width = maxCol - minCol + 1;
+    return true;
+}
+
+inline bool readPattern(std::istream& in, PatternFormat format, const RunSink& sink,
+                        PatternInfo& info, std::string& error) {
+    return format == PatternFormat::LIFE_106 ? readLife106(in, sink, info, error)
+                                             : readRle(in, sink, info, error);
+}
+
+// Set a run of cells alive on a torus, wrapping at the right and bottom edges
+inline void placeRun(BitGrid& grid, long long row, long long col, long long length) {
+    int rows = grid.getRows();
+    int cols = grid.getCols();
+    if (rows == 0 || cols == 0) return;
+    int r = static_cast<int>(((row % rows) + rows) % rows);
+    long long c = ((col % cols) + cols) % cols;
+    if (length >= cols) {
+        c = 0;
+        length = cols;
+    }
+
+    uint64_t* words = grid.row(r);
+    while (length > 0) {
+        long long span = length < cols - c ? length : cols - c;
+        long long end = c + span;
+        while (c < end) {
+            int bit = static_cast<int>(c & 63);
+            long long inWord = 64 - bit < end - c ? 64 - bit : end - c;
+            uint64_t mask = inWord == 64 ? ~0ULL : ((1ULL << inWord) - 1) << bit;
+            words[c >> 6] |= mask;
+            c += inWord;
+        }
+        length -= span;
+        c = 0;
+    }
+}
+
+// Writes runs of live cells as RLE. Runs must arrive in row-major order and
+// lie inside the width x height box given to the constructor.
+class RleWriter {
+private:
+    static const int LINE_LIMIT = 70;
+
+    std::ostream& out;
+    std::string line;
+    long long row;
+    long long col;
+
+    void emit(long long count, char tag) {
+        std::string token = count > 1 ? std::to_string(count) + tag : std::string(1, tag);
+        if (line.size() + token.size() > LINE_LIMIT) {
+            out << line << '\n';
+            line.clear();
+        }
+        line += token;
+    }
+
+public:
+    RleWriter(std::ostream& stream, long long width, long long height, const std::string& rule = "B3/S23")
+        : out(stream), row(0), col(0) {
+        out << "x = " << width << ", y = " << height << ", rule = " << rule << '\n';
+    }
+
+    void addRun(long long runRow, long long runCol, long long length) {
+        if (runRow > row) {
+            emit(runRow - row, '$');
+            row = runRow;
+            col = 0;
+        }
+        if (runCol > col) {
+            emit(runCol - col, 'b');
+        }
+        emit(length, 'o');
+        col = runCol + length;
+    }
+
+    void finish() {
+        line += '!';
+        out << line << '\n';
+        line.clear();
+    }
+};
+
+// Writes live cells as Life 1.06 coordinates
+class Life106Writer {
+private:
+    std::ostream& out;
+
+public:
+    explicit Life106Writer(std::ostream& stream) : out(stream) {
+        out << "#Life 1.06\n";
+    }
+
+    void addRun(long long row, long long col, long long length) {
+        for (long long i = 0; i < length; i++) {
+            out << (col + i) << ' ' << row << '\n';
+        }
+    }
+
+    void finish() {}
+};
+
+// Call sink for every maximal run of live cells in a grid, in row-major order
+template <typename Sink>
+void forEachRun(const BitGrid& grid, Sink&& sink) {
+    int words = grid.getWordsPerRow();
+    for (int r = 0; r < grid.getRows(); r++) {
+        const uint64_t* row = grid.row(r);
+        long long runStart = -1;
+        for (int w = 0; w < words; w++) {
+            uint64_t word = row[w];
+            long long base = static_cast<long long>(w) * 64;
+            int bit = 0;
+            while (bit < 64) {
+                // Skip to the next change between dead and alive
+                uint64_t rest = runStart < 0 ? word >> bit : ~word >> bit;
+                if (rest == 0) break;
+                bit += __builtin_ctzll(rest);
+                if (runStart < 0) {
+                    runStart = base + bit;
+                } else {
+                    sink(static_cast<long long>(r), runStart, base + bit - runStart);
+                    runStart = -1;
+                }
+            }
+        }
+        if (runStart >= 0) {
+            sink(static_cast<long long>(r), runStart, grid.getCols() - runStart);
+        }
+    }
+}
+
+inline void writeRle(std::ostream& out, const BitGrid& grid, const std::string& rule = "B3/S23") {
+    RleWriter writer(out, grid.getCols(), grid.getRows(), rule);
+    forEachRun(grid, [&](long long row, long long col, long long length) { writer.addRun(row, col, length); });
+    writer.finish();
+}
+
+inline void writeLife106(std::ostream& out, const BitGrid& grid) {
+    Life106Writer writer(out);
+    forEachRun(grid, [&](long long row, long long col, long long length) { writer.addRun(row, col, length); });
+}
+
+} // namespace life
+
+#endif // LIFE_PATTERN_IO_HPP
@@ -0,0 +1,396 @@
+// Runtime-dispatched SIMD generation kernels for the bit-packed Life grid
+//
+// Every variant runs the same full-adder tree from bit_grid.hpp, just on 2, 4
+// or 8 words per instruction, so all of them produce bit-identical results.
+// The instruction set is chosen once at startup from the CPU's feature flags,
+// so a single binary runs on any x86-64 host and uses the widest unit it has.
+//
+// The region loops are templates over the rule operation (life_rule.hpp), so
+// each instruction set has a B3/S23 kernel, compiled kernels for the rules
+// known in advance and one table-driven kernel shared by every other rule.
+
+#ifndef LIFE_SIMD_KERNELS_HPP
+#define LIFE_SIMD_KERNELS_HPP
+
+#include "bit_grid.hpp"
+#include "life_rule.hpp"
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LIFE_X86_SIMD 1
+#else
+#define LIFE_X86_SIMD 0
+#endif
+
+namespace life {
+
+// Instruction sets the kernel can be compiled for, narrowest first
+enum class SimdLevel {
+    PORTABLE,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::PORTABLE: return "Portable";
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::AVX512: return "AVX-512";
+        default: return "Unknown";
+    }
+}
+
+inline bool simdLevelSupported(SimdLevel level) {
+#if LIFE_X86_SIMD
+    __builtin_cpu_init();
+    switch (level) {
+        case SimdLevel::PORTABLE: return true;
+        case SimdLevel::SSE2: return __builtin_cpu_supports("sse2");
+        case SimdLevel::AVX2: return __builtin_cpu_supports("avx2");
+        case SimdLevel::AVX512: return __builtin_cpu_supports("avx512f");
+        default: return false;
+    }
+#else
+    return level == SimdLevel::PORTABLE;
+#endif
+}
+
+// Widest instruction set the running CPU supports
+inline SimdLevel detectSimdLevel() {
+    const SimdLevel widestFirst[] = { SimdLevel::AVX512, SimdLevel::AVX2, SimdLevel::SSE2 };
+    for (SimdLevel level : widestFirst) {
+        if (simdLevelSupported(level)) {
+            return level;
+        }
+    }
+    return SimdLevel::PORTABLE;
+}
+
+// Compute rows [rowBegin, rowEnd), words [wordBegin, wordEnd) of the next generation
+using StepRegionFn = void (*)(const BitGrid& current, BitGrid& next, int rowBegin, int rowEnd,
+                              int wordBegin, int wordEnd);
+
+// The same for any rule; only the table-driven kernels read the table
+using RuleRegionFn = void (*)(const BitGrid& current, BitGrid& next, int rowBegin, int rowEnd,
+                              int wordBegin, int wordEnd, const RuleTable& table);
+
+template <typename Op>
+LIFE_ALWAYS_INLINE void stepRegionPortableWith(const Op& op, const BitGrid& current, BitGrid& next,
+                                               int rowBegin, int rowEnd, int wordBegin, int wordEnd) {
+    int rows = current.getRows();
+    int wordsPerRow = current.getWordsPerRow();
+    for (int r = rowBegin; r < rowEnd; r++) {
+        const uint64_t* above = current.row((r - 1 + rows) % rows);
+        const uint64_t* here = current.row(r);
+        const uint64_t* below = current.row((r + 1) % rows);
+        uint64_t* out = next.row(r);
+        for (int w = wordBegin; w < wordEnd; w++) {
+            out[w] = stepWordWith(op, current, above, here, below, w);
+        }
+        if (wordEnd == wordsPerRow) {
+            out[wordsPerRow - 1] &= current.lastWordMask();
+        }
+    }
+}
+
+inline void stepRegionPortable(const BitGrid& current, BitGrid& next, int rowBegin, int rowEnd,
+                               int wordBegin, int wordEnd) {
+    stepRegionPortableWith(ConwayOp(), current, next, rowBegin, rowEnd, wordBegin, wordEnd);
+}
+
+// Rule operation for a kernel: compiled rules ignore the table
+template <typename Op>
+struct RuleOpFor {
+    static Op make(const RuleTable&) { return Op(); }
+};
+
+template <>
+struct RuleOpFor<TableRuleOp> {
+    static TableRuleOp make(const RuleTable& table) { return TableRuleOp(table); }
+};
+
+template <typename Op>
+inline void ruleRegionPortable(const BitGrid& current, BitGrid& next, int rowBegin, int rowEnd,
+                               int wordBegin, int wordEnd, const RuleTable& table) {
+    stepRegionPortableWith(RuleOpFor<Op>::make(table), current, next, rowBegin, rowEnd, wordBegin, wordEnd);
+}
+
+#if LIFE_X86_SIMD
+
+typedef uint64_t WordsX2 __attribute__((vector_size(16)));
+typedef uint64_t WordsX4 __attribute__((vector_size(32)));
+typedef uint64_t WordsX8 __attribute__((vector_size(64)));
+
+template <typename Lanes>
+LIFE_ALWAYS_INLINE void loadLanes(const uint64_t* p, Lanes& v) {
+    __builtin_memcpy(&v, p, sizeof(Lanes));
+}
+
+// Vector body shared by all SIMD variants. The first and last word of each row
+// need torus wraparound, so they go through the scalar path; every word in
+// between reads its west/east carry bits from the neighbouring words directly.
+template <typename Lanes, typename Op>
+LIFE_ALWAYS_INLINE void stepRegionLanes(const Op& op, const BitGrid& current, BitGrid& next,
+                                        int rowBegin, int rowEnd, int wordBegin, int wordEnd) {
+    const int lanes = sizeof(Lanes) / sizeof(uint64_t);
+    int rows = current.getRows();
+    int wordsPerRow = current.getWordsPerRow();
+
+    for (int r = rowBegin; r < rowEnd; r++) {
+        const uint64_t* above = current.row((r - 1 + rows) % rows);
+        const uint64_t* here = current.row(r);
+        const uint64_t* below = current.row((r + 1) % rows);
+        uint64_t* out = next.row(r);
+
+        int w = wordBegin;
+        if (w == 0 && w < wordEnd) {
+            out[0] = stepWordWith(op, current, above, here, below, 0);
+            w = 1;
+        }
+        for (; w + lanes <= wordEnd && w + lanes < wordsPerRow; w += lanes) {
+            Lanes aPrev, a, aNext, bPrev, b, bNext, cPrev, c, cNext;
+            loadLanes(above + w - 1, aPrev); loadLanes(above + w, a); loadLanes(above + w + 1, aNext);
+            loadLanes(here + w - 1, bPrev); loadLanes(here + w, b); loadLanes(here + w + 1, bNext);
+            loadLanes(below + w - 1, cPrev); loadLanes(below + w, c); loadLanes(below + w + 1, cNext);
+
+            Lanes aW = (a << 1) | (aPrev >> 63), aE = (a >> 1) | (aNext << 63);
+            Lanes bW = (b << 1) | (bPrev >> 63), bE = (b >> 1) | (bNext << 63);
+            Lanes cW = (c << 1) | (cPrev >> 63), cE = (c >> 1) | (cNext << 63);
+            Lanes result;
+            op.apply(aW, a, aE, bW, b, bE, cW, c, cE, result);
+            __builtin_memcpy(out + w, &result, sizeof(Lanes));
+        }
+        for (; w < wordEnd; w++) {
+            out[w] = stepWordWith(op, current, above, here, below, w);
+        }
+        if (wordEnd == wordsPerRow) {
+            out[wordsPerRow - 1] &= current.lastWordMask();
+        }
+    }
+}
+
+__attribute__((target("sse2")))
+inline void stepRegionSse2(const BitGrid& current, BitGrid& next, int rowBegin, int rowEnd,
+                           int wordBegin, int wordEnd) {
+    stepRegionLanes<WordsX2>(ConwayOp(), current, next, rowBegin, rowEnd, wordBegin, wordEnd);
+}
+
+template <typename Op>
+__attribute__((target("sse2")))
+inline void ruleRegionSse2(const BitGrid& current, BitGrid& next, int rowBegin, int rowEnd,
+                           int wordBegin, int wordEnd, const RuleTable& table) {
+    stepRegionLanes<WordsX2>(RuleOpFor<Op>::make(table), current, next, rowBegin, rowEnd, wordBegin, wordEnd);
+}
+
+__attribute__((target("avx2")))
+inline void stepRegionAvx2(const BitGrid& current, BitGrid& next, int rowBegin, int rowEnd,
+                           int wordBegin, int wordEnd) {
+    stepRegionLanes<WordsX4>(ConwayOp(), current, next, rowBegin, rowEnd, wordBegin, wordEnd);
+}
+
+template <typename Op>
+__attribute__((target("avx2")))
+inline void ruleRegionAvx2(const BitGrid& current, BitGrid& next, int rowBegin, int rowEnd,
+                           int wordBegin, int wordEnd, const RuleTable& table) {
+    stepRegionLanes<WordsX4>(RuleOpFor<Op>::make(table), current, next, rowBegin, rowEnd, wordBegin, wordEnd);
+}
+
+__attribute__((target("avx512f")))
+inline void stepRegionAvx512(const BitGrid& current, BitGrid& next, int rowBegin, int rowEnd,
+                             int wordBegin, int wordEnd) {
+    stepRegionLanes<WordsX8>(ConwayOp(), current, next, rowBegin, rowEnd, wordBegin, wordEnd);
+}
+
+template <typename Op>
+__attribute__((target("avx512f")))
+inline void ruleRegionAvx512(const BitGrid& current, BitGrid& next, int rowBegin, int rowEnd,
+                             int wordBegin, int wordEnd, const RuleTable& table) {
+    stepRegionLanes<WordsX8>(RuleOpFor<Op>::make(table), current, next, rowBegin, rowEnd, wordBegin, wordEnd);
+}
+
+#endif // LIFE_X86_SIMD
+
+// Kernel for a given instruction set; the caller must check simdLevelSupported first
+inline StepRegionFn stepRegionFor(SimdLevel level) {
+    switch (level) {
+#if LIFE_X86_SIMD
+        case SimdLevel::SSE2: return stepRegionSse2;
+        case SimdLevel::AVX2: return stepRegionAvx2;
+        case SimdLevel::AVX512: return stepRegionAvx512;
+#endif
+        default: return stepRegionPortable;
+    }
+}
+
+// Rule kernel for a given instruction set; the caller must check simdLevelSupported first
+template <typename Op>
+inline RuleRegionFn ruleRegionFor(SimdLevel level) {
+    switch (level) {
+#if LIFE_X86_SIMD
+        case SimdLevel::SSE2: return ruleRegionSse2<Op>;
+        case SimdLevel::AVX2: return ruleRegionAvx2<Op>;
+        case SimdLevel::AVX512: return ruleRegionAvx512<Op>;
+#endif
+        default: return ruleRegionPortable<Op>;
+    }
+}
+
+// A rule's region kernel together with the table it reads
+struct RuleKernel {
+    RuleRegionFn region;
+    RuleTable table;
+
+    void operator()(const BitGrid& current, BitGrid& next, int rowBegin, int rowEnd,
+                    int wordBegin, int wordEnd) const {
+        region(current, next, rowBegin, rowEnd, wordBegin, wordEnd, table);
+    }
+};
+
+// Compiled kernel when the rule is known in advance, else the table-driven one
+inline RuleKernel ruleKernelFor(SimdLevel level, const Rule& rule) {
+    RuleKernel kernel;
+    kernel.table = RuleTable(rule);
+    if (rule == CONWAY) {
+        kernel.region = ruleRegionFor<ConwayOp>(level);
+    } else if (rule == HIGHLIFE) {
+        kernel.region = ruleRegionFor<HighLifeOp>(level);
+    } else if (rule == DAY_AND_NIGHT) {
+        kernel.region = ruleRegionFor<DayAndNightOp>(level);
+    } else {
+        kernel.region = ruleRegionFor<TableRuleOp>(level);
+    }
+    return kernel;
+}
+
+// Instruction set picked at startup
+inline SimdLevel activeSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+// Widest available kernel, for callers that step part of the grid
+inline StepRegionFn fastStepRegion() {
+    static const StepRegionFn kernel = stepRegionFor(activeSimdLevel());
+    return kernel;
+}
+
+// Compute the whole next generation with the widest available kernel
+inline void stepFast(const BitGrid& current, BitGrid& next) {
+    fastStepRegion()(current, next, 0, current.getRows(), 0, current.getWordsPerRow());
+}
+
+// Widest available kernel for a rule
+inline RuleKernel fastRuleKernel(const Rule& rule) {
+    return ruleKernelFor(activeSimdLevel(), rule);
+}
+
+// Reference next generation computed one cell at a time
+inline void stepReference(const BitGrid& current, BitGrid& next, const Rule& rule = CONWAY) {
+    int rows = current.getRows();
+    int cols = current.getCols();
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            int neighbors = 0;
+            for (int di = -1; di <= 1; di++) {
+                for (int dj = -1; dj <= 1; dj++) {
+                    if (di == 0 && dj == 0) continue;
+                    neighbors += current.get((i + di + rows) % rows, (j + dj + cols) % cols);
+                }
+            }
+            next.set(i, j, ruleNextState(rule, current.get(i, j), neighbors));
+        }
+    }
+}
+
+// Run every supported kernel on random soups of awkward sizes and compare
+// each generation against the per-cell reference. Soups take turns between
+// B3/S23, the compiled rules and table-driven ones (including a B0 rule).
+// Returns true if all match.
+inline bool runKernelSelfCheck(std::ostream& out, int soups = 50, int generations = 16, unsigned seed = 12345) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> sizeDis(1, 300);
+    std::uniform_real_distribution<double> densityDis(0.05, 0.6);
+
+    const SimdLevel levels[] = { SimdLevel::PORTABLE, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 };
+    const Rule rules[] = { CONWAY, HIGHLIFE, DAY_AND_NIGHT,
+                           { countMask("1357"), countMask("1357") },
+                           { countMask("0123478"), countMask("01234678") } };
+    const int ruleCount = sizeof(rules) / sizeof(rules[0]);
+    bool allPassed = true;
+
+    for (SimdLevel level : levels) {
+        if (!simdLevelSupported(level)) {
+            out << "  " << simdLevelName(level) << ": not supported on this CPU, skipped\n";
+            continue;
+        }
+
+        StepRegionFn conwayKernel = stepRegionFor(level);
+        std::mt19937 soupGen(gen());
+        bool passed = true;
+
+        for (int soup = 0; soup < soups && passed; soup++) {
+            int rows = sizeDis(soupGen);
+            int cols = sizeDis(soupGen);
+            double density = densityDis(soupGen);
+            std::bernoulli_distribution alive(density);
+
+            BitGrid grid(rows, cols);
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    grid.set(i, j, alive(soupGen));
+                }
+            }
+
+            const Rule& rule = rules[soup % ruleCount];
+            RuleKernel ruleKernel = ruleKernelFor(level, rule);
+            BitGrid expected(rows, cols);
+            BitGrid actual(rows, cols);
+            auto kernel = [&](const BitGrid& current, BitGrid& next, int rowBegin, int rowEnd,
+                              int wordBegin, int wordEnd) {
+                if (rule == CONWAY) {
+                    conwayKernel(current, next, rowBegin, rowEnd, wordBegin, wordEnd);
+                } else {
+                    ruleKernel(current, next, rowBegin, rowEnd, wordBegin, wordEnd);
+                }
+            };
+            int words = grid.getWordsPerRow();
+            for (int g = 0; g < generations; g++) {
+                stepReference(grid, expected, rule);
+                // Odd generations are computed as four regions split at random
+                if (g % 2 == 0) {
+                    kernel(grid, actual, 0, rows, 0, words);
+                } else {
+                    int splitRow = std::uniform_int_distribution<int>(0, rows)(soupGen);
+                    int splitWord = std::uniform_int_distribution<int>(0, words)(soupGen);
+                    kernel(grid, actual, 0, splitRow, 0, splitWord);
+                    kernel(grid, actual, 0, splitRow, splitWord, words);
+                    kernel(grid, actual, splitRow, rows, 0, splitWord);
+                    kernel(grid, actual, splitRow, rows, splitWord, words);
+                }
+                if (actual != expected) {
+                    out << "  " << simdLevelName(level) << ": MISMATCH on " << rows << "x" << cols
+                        << " soup " << soup << " (" << ruleString(rule) << ") at generation " << g << "\n";
+                    passed = false;
+                    break;
+                }
+                grid = expected;
+            }
+        }
+
+        if (passed) {
+            out << "  " << simdLevelName(level) << ": OK (" << soups << " soups, " << ruleCount << " rules)\n";
+        }
+        allPassed = allPassed && passed;
+    }
+
+    return allPassed;
+}
+
+} // namespace life
+
+#endif // LIFE_SIMD_KERNELS_HPP
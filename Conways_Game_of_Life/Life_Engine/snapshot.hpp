@@ -0,0 +1,345 @@
+// Compact binary snapshots of a BitGrid, opened through a memory mapping
+//
+// Layout (host byte order, every section 8-byte aligned):
+//   SnapshotHeader   dimensions, generation, rule, origin and life::hashGrid checksum
+//   SnapshotBand[]   one entry per band of bandRows rows: offset, size, encoding
+//   band data        the band's words exactly as BitGrid stores them (RAW), or
+//                    zero-run coded (ZERO_RUNS) when that is smaller
+//
+// A raw snapshot is the grid's own memory image: opening it maps the file and
+// checks the header, after which rows can be read straight out of the mapping
+// and loading is one copy per band. Zero-run coding is a word-level run-length
+// scheme rather than a general-purpose compressor, so it needs no library and
+// decodes at memory speed; it shrinks the mostly empty bands of sparse boards
+// and is skipped for dense bands where it would not pay off.
+
+#ifndef LIFE_SNAPSHOT_HPP
+#define LIFE_SNAPSHOT_HPP
+
+#include "bit_grid.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace life {
+
+const char SNAPSHOT_MAGIC[8] = {'L', 'I', 'F', 'E', 'S', 'N', 'A', 'P'};
+const uint32_t SNAPSHOT_VERSION = 1;
+const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;  // Reads back differently on a foreign-endian host
+const int SNAPSHOT_BAND_ROWS = 64;
+
+enum class BandEncoding : uint32_t {
+    RAW = 0,
+    ZERO_RUNS = 1   // Control words (zeros << 32 | literals), each followed by its literal words
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    int32_t rows;
+    int32_t cols;
+    int64_t generation;
+    int64_t originRow;      // Plane position of the top-left cell (0 for a torus)
+    int64_t originCol;
+    uint64_t checksum;      // life::hashGrid of the cells
+    uint32_t bandRows;
+    uint32_t bandCount;
+    char rule[32];          // NUL-terminated rule string, e.g. "B3/S23"
+};
+static_assert(sizeof(SnapshotHeader) == 96, "snapshot header layout must not depend on the compiler");
+
+struct SnapshotBand {
+    uint64_t offset;        // From the start of the file
+    uint64_t bytes;
+    uint32_t encoding;      // BandEncoding
+    uint32_t reserved;
+};
+static_assert(sizeof(SnapshotBand) == 24, "snapshot band layout must not depend on the compiler");
+
+// What a snapshot records besides the cells
+struct SnapshotInfo {
+    long long generation = 0;
+    long long originRow = 0;
+    long long originCol = 0;
+    std::string rule = "B3/S23";
+};
+
+// Whether a file name has the snapshot extension (.snap)
+inline bool isSnapshotFile(const std::string& filename) {
+    std::string::size_type dot = filename.rfind('.');
+    return dot != std::string::npos && filename.compare(dot, std::string::npos, ".snap") == 0;
+}
+
+// Append the zero-run coding of words to out
+inline void encodeZeroRuns(const uint64_t* words, std::size_t count, std::vector<uint64_t>& out) {
+    std::size_t i = 0;
+    while (i < count) {
+        uint64_t zeros = 0;
+        while (i < count && words[i] == 0 && zeros < 0xFFFFFFFFULL) {
+            zeros++;
+            i++;
+        }
+        std::size_t literalBegin = i;
+        while (i < count && words[i] != 0 && i - literalBegin < 0xFFFFFFFFULL) {
+            i++;
+        }
+        out.push_back((zeros << 32) | (i - literalBegin));
+        out.insert(out.end(), words + literalBegin, words + i);
+    }
+}
+
+// Decode exactly count words; false if the coded data is truncated or overlong
+inline bool decodeZeroRuns(const uint64_t* coded, std::size_t codedCount, uint64_t* words, std::size_t count) {
+    std::size_t in = 0;
+    std::size_t out = 0;
+    while (in < codedCount) {
+        uint64_t zeros = coded[in] >> 32;
+        uint64_t literals = coded[in] & 0xFFFFFFFFULL;
+        in++;
+        if (zeros > count - out || literals > count - out - zeros || literals > codedCount - in) {
+            return false;
+        }
+        std::memset(words + out, 0, zeros * sizeof(uint64_t));
+        out += zeros;
+        std::memcpy(words + out, coded + in, literals * sizeof(uint64_t));
+        out += literals;
+        in += literals;
+    }
+    return out == count;
+}
+
+// Write grid to path. With compress, each band is zero-run coded when that is smaller.
+inline bool writeSnapshot(const std::string& path, const BitGrid& grid, const SnapshotInfo& info,
+                          bool compress, std::string& error) {
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.rows = grid.getRows();
+    header.cols = grid.getCols();
+    header.generation = info.generation;
+    header.originRow = info.originRow;
+    header.originCol = info.originCol;
+    header.checksum = hashGrid(grid);
+    header.bandRows = SNAPSHOT_BAND_ROWS;
+    header.bandCount = static_cast<uint32_t>((grid.getRows() + SNAPSHOT_BAND_ROWS - 1) / SNAPSHOT_BAND_ROWS);
+    std::strncpy(header.rule, info.rule.c_str(), sizeof(header.rule) - 1);
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        error = "cannot open " + path + " for writing";
+        return false;
+    }
+
+    // Header and band table are written last, once the band sizes are known
+    std::vector<SnapshotBand> bands(header.bandCount);
+    uint64_t offset = sizeof(SnapshotHeader) + bands.size() * sizeof(SnapshotBand);
+    bool ok = std::fseek(file, static_cast<long>(offset), SEEK_SET) == 0;
+
+    std::vector<uint64_t> coded;
+    for (uint32_t b = 0; ok && b < header.bandCount; b++) {
+        int rowBegin = static_cast<int>(b) * SNAPSHOT_BAND_ROWS;
+        int rowEnd = rowBegin + SNAPSHOT_BAND_ROWS < grid.getRows() ? rowBegin + SNAPSHOT_BAND_ROWS : grid.getRows();
+        const uint64_t* words = grid.row(rowBegin);
+        std::size_t count = static_cast<std::size_t>(rowEnd - rowBegin) * grid.getWordsPerRow();
+
+        bands[b].offset = offset;
+        bands[b].encoding = static_cast<uint32_t>(BandEncoding::RAW);
+        if (compress) {
+            coded.clear();
+            encodeZeroRuns(words, count, coded);
+            if (coded.size() < count) {
+                words = coded.data();
+                count = coded.size();
+                bands[b].encoding = static_cast<uint32_t>(BandEncoding::ZERO_RUNS);
+            }
+        }
+        bands[b].bytes = count * sizeof(uint64_t);
+        ok = std::fwrite(words, sizeof(uint64_t), count, file) == count;
+        offset += bands[b].bytes;
+    }
+
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0
+            && std::fwrite(&header, sizeof(header), 1, file) == 1
+            && std::fwrite(bands.data(), sizeof(SnapshotBand), bands.size(), file) == bands.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        error = "failed writing " + path;
+    }
+    return ok;
+}
+
+// Read-only mapping of a snapshot file. Opening validates the header and band
+// table; the cells are only touched by rawRow() and load().
+class MappedSnapshot {
+private:
+    const unsigned char* base;
+    std::size_t size;
+#if defined(_WIN32)
+    std::vector<unsigned char> contents;  // No mmap: the file is read in whole
+#endif
+
+    const SnapshotHeader& header() const { return *reinterpret_cast<const SnapshotHeader*>(base); }
+    const SnapshotBand& band(int b) const {
+        return reinterpret_cast<const SnapshotBand*>(base + sizeof(SnapshotHeader))[b];
+    }
+
+    std::size_t bandWords(int b) const {
+        int rowBegin = b * static_cast<int>(header().bandRows);
+        int rowEnd = rowBegin + static_cast<int>(header().bandRows);
+        if (rowEnd > header().rows) rowEnd = header().rows;
+        return static_cast<std::size_t>(rowEnd - rowBegin) * ((header().cols + 63) / 64);
+    }
+
+    bool validate(std::string& error) const {
+        if (size < sizeof(SnapshotHeader) || std::memcmp(header().magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+            error = "not a Life snapshot";
+            return false;
+        }
+        const SnapshotHeader& h = header();
+        if (h.byteOrder != SNAPSHOT_BYTE_ORDER || h.version != SNAPSHOT_VERSION) {
+            error = "snapshot was written by an incompatible version or byte order";
+            return false;
+        }
+        if (h.rows <= 0 || h.cols <= 0 || h.bandRows == 0
+            || h.bandCount != (static_cast<uint64_t>(h.rows) + h.bandRows - 1) / h.bandRows
+            || size < sizeof(SnapshotHeader) + static_cast<uint64_t>(h.bandCount) * sizeof(SnapshotBand)) {
+            error = "snapshot header is corrupt";
+            return false;
+        }
+        for (int b = 0; b < static_cast<int>(h.bandCount); b++) {
+            const SnapshotBand& entry = band(b);
+            bool raw = entry.encoding == static_cast<uint32_t>(BandEncoding::RAW);
+            if (entry.offset % sizeof(uint64_t) != 0 || entry.bytes % sizeof(uint64_t) != 0
+                || entry.offset > size || entry.bytes > size - entry.offset
+                || (raw && entry.bytes != bandWords(b) * sizeof(uint64_t))
+                || (!raw && entry.encoding != static_cast<uint32_t>(BandEncoding::ZERO_RUNS))) {
+                error = "snapshot band " + std::to_string(b) + " is corrupt";
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    MappedSnapshot() : base(nullptr), size(0) {}
+    ~MappedSnapshot() { close(); }
+
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+    bool open(const std::string& path, std::string& error) {
+        close();
+#if defined(_WIN32)
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            error = "cannot open " + path;
+            return false;
+        }
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        base = contents.data();
+        size = contents.size();
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            error = "cannot open " + path;
+            return false;
+        }
+        struct stat status;
+        void* mapping = MAP_FAILED;
+        if (fstat(fd, &status) == 0 && status.st_size > 0) {
+            mapping = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            error = "cannot map " + path;
+            return false;
+        }
+        base = static_cast<const unsigned char*>(mapping);
+        size = static_cast<std::size_t>(status.st_size);
+#endif
+        if (!validate(error)) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+#if defined(_WIN32)
+        contents.clear();
+#else
+        if (base) {
+            munmap(const_cast<unsigned char*>(base), size);
+        }
+#endif
+        base = nullptr;
+        size = 0;
+    }
+
+    bool isOpen() const { return base != nullptr; }
+    int getRows() const { return header().rows; }
+    int getCols() const { return header().cols; }
+    uint64_t getChecksum() const { return header().checksum; }
+
+    SnapshotInfo getInfo() const {
+        SnapshotInfo info;
+        info.generation = header().generation;
+        info.originRow = header().originRow;
+        info.originCol = header().originCol;
+        info.rule = std::string(header().rule, strnlen(header().rule, sizeof(header().rule)));
+        return info;
+    }
+
+    // Words of row r read straight from the mapping, or nullptr if its band is coded
+    const uint64_t* rawRow(int r) const {
+        int b = r / static_cast<int>(header().bandRows);
+        if (band(b).encoding != static_cast<uint32_t>(BandEncoding::RAW)) {
+            return nullptr;
+        }
+        int rowInBand = r - b * static_cast<int>(header().bandRows);
+        return reinterpret_cast<const uint64_t*>(base + band(b).offset) + static_cast<std::size_t>(rowInBand) * ((header().cols + 63) / 64);
+    }
+
+    // Copy the cells into grid, resizing it, and verify the checksum
+    bool load(BitGrid& grid, std::string& error) const {
+        if (grid.getRows() != getRows() || grid.getCols() != getCols()) {
+            grid = BitGrid(getRows(), getCols());
+        }
+        for (int b = 0; b < static_cast<int>(header().bandCount); b++) {
+            const SnapshotBand& entry = band(b);
+            const uint64_t* words = reinterpret_cast<const uint64_t*>(base + entry.offset);
+            uint64_t* target = grid.row(b * static_cast<int>(header().bandRows));
+            std::size_t count = bandWords(b);
+            if (entry.encoding == static_cast<uint32_t>(BandEncoding::RAW)) {
+                std::memcpy(target, words, count * sizeof(uint64_t));
+            } else if (!decodeZeroRuns(words, entry.bytes / sizeof(uint64_t), target, count)) {
+                error = "snapshot band " + std::to_string(b) + " does not decode";
+                return false;
+            }
+        }
+        if (hashGrid(grid) != getChecksum()) {
+            error = "snapshot checksum mismatch";
+            return false;
+        }
+        return true;
+    }
+};
+
+} // namespace life
+
+#endif // LIFE_SNAPSHOT_HPP
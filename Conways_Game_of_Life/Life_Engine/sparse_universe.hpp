@@ -0,0 +1,353 @@
+// Unbounded Life plane stored as a hash map of occupied chunks
+//
+// The plane is cut into CHUNK_SIZE x CHUNK_SIZE chunks, one 64-bit word per
+// chunk row (bit j of a row holds column chunkCol * 64 + j, as in BitGrid).
+// Only chunks that hold live cells are kept, so memory follows the population
+// rather than the bounding box. Before each step, every chunk with live cells
+// on an edge or corner makes sure the chunk on that side exists, since births
+// can spill across; chunks that end a step empty are freed.
+//
+// Any Life-like rule without B0 can be used (setRule); with B0 empty space
+// would come alive and the plane would no longer be sparse.
+
+#ifndef LIFE_SPARSE_UNIVERSE_HPP
+#define LIFE_SPARSE_UNIVERSE_HPP
+
+#include "bit_grid.hpp"
+#include "life_rule.hpp"
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+class SparseUniverse {
+public:
+    static const int CHUNK_SIZE = 64;
+
+private:
+    struct Chunk {
+        uint64_t rows[CHUNK_SIZE];
+        uint64_t next[CHUNK_SIZE];
+
+        Chunk() {
+            std::memset(rows, 0, sizeof(rows));
+            std::memset(next, 0, sizeof(next));
+        }
+    };
+
+    std::unordered_map<uint64_t, Chunk> chunks;
+    long long generation;
+    bool changed;  // Whether the last step altered any cell
+    bool conway;   // B3/S23 takes the reduced kernel; other rules read the table
+    life::RuleTable ruleTable;
+
+    // Chunk coordinates packed into one key: row in the high half, column in the low half
+    static uint64_t keyOf(int32_t chunkRow, int32_t chunkCol) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(chunkRow)) << 32) | static_cast<uint32_t>(chunkCol);
+    }
+    static int32_t chunkRowOf(uint64_t key) { return static_cast<int32_t>(key >> 32); }
+    static int32_t chunkColOf(uint64_t key) { return static_cast<int32_t>(key & 0xFFFFFFFFULL); }
+
+    // Floor division by the chunk size, also for negative coordinates
+    static int32_t chunkOf(long long coordinate) {
+        return static_cast<int32_t>(coordinate >> 6);
+    }
+
+    const Chunk* find(int32_t chunkRow, int32_t chunkCol) const {
+        auto it = chunks.find(keyOf(chunkRow, chunkCol));
+        return it == chunks.end() ? nullptr : &it->second;
+    }
+
+    static bool isEmpty(const uint64_t* rows) {
+        for (int r = 0; r < CHUNK_SIZE; r++) {
+            if (rows[r]) return false;
+        }
+        return true;
+    }
+
+    // Make sure every chunk a birth could spill into exists before stepping
+    void allocateBorders() {
+        std::vector<uint64_t> missing;
+        auto need = [&](int32_t chunkRow, int32_t chunkCol) {
+            uint64_t key = keyOf(chunkRow, chunkCol);
+            if (chunks.find(key) == chunks.end()) {
+                missing.push_back(key);
+            }
+        };
+
+        for (const auto& entry : chunks) {
+            const uint64_t* rows = entry.second.rows;
+            int32_t cr = chunkRowOf(entry.first);
+            int32_t cc = chunkColOf(entry.first);
+
+            uint64_t anyRow = 0;
+            for (int r = 0; r < CHUNK_SIZE; r++) {
+                anyRow |= rows[r];
+            }
+            uint64_t top = rows[0];
+            uint64_t bottom = rows[CHUNK_SIZE - 1];
+
+            if (top) need(cr - 1, cc);
+            if (bottom) need(cr + 1, cc);
+            if (anyRow & 1ULL) need(cr, cc - 1);
+            if (anyRow >> 63) need(cr, cc + 1);
+            if (top & 1ULL) need(cr - 1, cc - 1);
+            if (top >> 63) need(cr - 1, cc + 1);
+            if (bottom & 1ULL) need(cr + 1, cc - 1);
+            if (bottom >> 63) need(cr + 1, cc + 1);
+        }
+
+        for (uint64_t key : missing) {
+            chunks.emplace(key, Chunk());
+        }
+    }
+
+    // Next state of one chunk into its next buffer, reading the ring of cells
+    // around it from the eight neighbouring chunks (missing ones are empty)
+    void stepChunk(uint64_t key, Chunk& chunk) const {
+        int32_t cr = chunkRowOf(key);
+        int32_t cc = chunkColOf(key);
+        const Chunk* n = find(cr - 1, cc);
+        const Chunk* s = find(cr + 1, cc);
+        const Chunk* w = find(cr, cc - 1);
+        const Chunk* e = find(cr, cc + 1);
+        const Chunk* nw = find(cr - 1, cc - 1);
+        const Chunk* ne = find(cr - 1, cc + 1);
+        const Chunk* sw = find(cr + 1, cc - 1);
+        const Chunk* se = find(cr + 1, cc + 1);
+
+        // Rows -1..CHUNK_SIZE of this chunk and of its west/east neighbours
+        const int last = CHUNK_SIZE - 1;
+        uint64_t here[CHUNK_SIZE + 2], west[CHUNK_SIZE + 2], east[CHUNK_SIZE + 2];
+        here[0] = n ? n->rows[last] : 0;
+        west[0] = nw ? nw->rows[last] : 0;
+        east[0] = ne ? ne->rows[last] : 0;
+        for (int r = 0; r < CHUNK_SIZE; r++) {
+            here[r + 1] = chunk.rows[r];
+            west[r + 1] = w ? w->rows[r] : 0;
+            east[r + 1] = e ? e->rows[r] : 0;
+        }
+        here[CHUNK_SIZE + 1] = s ? s->rows[0] : 0;
+        west[CHUNK_SIZE + 1] = sw ? sw->rows[0] : 0;
+        east[CHUNK_SIZE + 1] = se ? se->rows[0] : 0;
+
+        uint64_t shiftedW[CHUNK_SIZE + 2], shiftedE[CHUNK_SIZE + 2];
+        for (int r = 0; r < CHUNK_SIZE + 2; r++) {
+            shiftedW[r] = (here[r] << 1) | (west[r] >> 63);
+            shiftedE[r] = (here[r] >> 1) | (east[r] << 63);
+        }
+
+        if (conway) {
+            for (int r = 0; r < CHUNK_SIZE; r++) {
+                chunk.next[r] = life::conwayWord(shiftedW[r], here[r], shiftedE[r],
+                                                 shiftedW[r + 1], here[r + 1], shiftedE[r + 1],
+                                                 shiftedW[r + 2], here[r + 2], shiftedE[r + 2]);
+            }
+        } else {
+            for (int r = 0; r < CHUNK_SIZE; r++) {
+                chunk.next[r] = life::ruleWord(ruleTable, shiftedW[r], here[r], shiftedE[r],
+                                               shiftedW[r + 1], here[r + 1], shiftedE[r + 1],
+                                               shiftedW[r + 2], here[r + 2], shiftedE[r + 2]);
+            }
+        }
+    }
+
+public:
+    SparseUniverse() : generation(0), changed(false), conway(true) {}
+
+    // Rule for later steps; false (and no change) for rules with B0
+    bool setRule(const life::Rule& rule) {
+        if (!life::ruleKeepsVoid(rule)) {
+            return false;
+        }
+        conway = rule == life::CONWAY;
+        ruleTable = life::RuleTable(rule);
+        return true;
+    }
+
+    bool get(long long row, long long col) const {
+        const Chunk* chunk = find(chunkOf(row), chunkOf(col));
+        return chunk && ((chunk->rows[row & 63] >> (col & 63)) & 1ULL);
+    }
+
+    void set(long long row, long long col, bool alive) {
+        uint64_t bit = 1ULL << (col & 63);
+        uint64_t key = keyOf(chunkOf(row), chunkOf(col));
+        if (alive) {
+            chunks[key].rows[row & 63] |= bit;
+        } else {
+            auto it = chunks.find(key);
+            if (it != chunks.end()) {
+                it->second.rows[row & 63] &= ~bit;
+            }
+        }
+    }
+
+    void clear() {
+        chunks.clear();
+        generation = 0;
+        changed = false;
+    }
+
+    // Advance one generation on the unbounded plane
+    void step() {
+        allocateBorders();
+
+        for (auto& entry : chunks) {
+            stepChunk(entry.first, entry.second);
+        }
+
+        changed = false;
+        for (auto it = chunks.begin(); it != chunks.end();) {
+            Chunk& chunk = it->second;
+            if (std::memcmp(chunk.rows, chunk.next, sizeof(chunk.rows)) != 0) {
+                changed = true;
+                std::memcpy(chunk.rows, chunk.next, sizeof(chunk.rows));
+            }
+            if (isEmpty(chunk.rows)) {
+                it = chunks.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        generation++;
+    }
+
+    long long getGeneration() const { return generation; }
+    std::size_t getChunkCount() const { return chunks.size(); }
+
+    // True once a step has left every cell as it was (a still life or empty plane)
+    bool isStill() const { return generation > 0 && !changed; }
+
+    long long getPopulation() const {
+        long long count = 0;
+        for (const auto& entry : chunks) {
+            for (int r = 0; r < CHUNK_SIZE; r++) {
+                count += __builtin_popcountll(entry.second.rows[r]);
+            }
+        }
+        return count;
+    }
+
+    // Smallest rectangle holding every live cell; false if the plane is empty
+    bool getBounds(long long& top, long long& left, long long& bottom, long long& right) const {
+        bool found = false;
+        for (const auto& entry : chunks) {
+            long long baseRow = static_cast<long long>(chunkRowOf(entry.first)) * CHUNK_SIZE;
+            long long baseCol = static_cast<long long>(chunkColOf(entry.first)) * CHUNK_SIZE;
+            for (int r = 0; r < CHUNK_SIZE; r++) {
+                uint64_t word = entry.second.rows[r];
+                if (!word) continue;
+                long long row = baseRow + r;
+                long long first = baseCol + __builtin_ctzll(word);
+                long long lastCol = baseCol + 63 - __builtin_clzll(word);
+                if (!found) {
+                    top = bottom = row;
+                    left = first;
+                    right = lastCol;
+                    found = true;
+                } else {
+                    if (row < top) top = row;
+                    if (row > bottom) bottom = row;
+                    if (first < left) left = first;
+                    if (lastCol > right) right = lastCol;
+                }
+            }
+        }
+        return found;
+    }
+
+    // Place the live cells of a grid with its top-left corner at (top, left)
+    void loadFrom(const BitGrid& grid, long long top, long long left) {
+        for (int i = 0; i < grid.getRows(); i++) {
+            const uint64_t* row = grid.row(i);
+            for (int w = 0; w < grid.getWordsPerRow(); w++) {
+                uint64_t word = row[w];
+                while (word) {
+                    int bit = __builtin_ctzll(word);
+                    set(top + i, left + w * 64 + bit, true);
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
+    // Call sink(row, col, length) for every maximal run of live cells in
+    // row-major order, e.g. to export the plane without materialising it
+    template <typename Sink>
+    void forEachRun(Sink&& sink) const {
+        std::vector<uint64_t> keys;
+        keys.reserve(chunks.size());
+        for (const auto& entry : chunks) {
+            keys.push_back(entry.first);
+        }
+        std::sort(keys.begin(), keys.end(), [](uint64_t a, uint64_t b) {
+            int32_t rowA = chunkRowOf(a), rowB = chunkRowOf(b);
+            return rowA != rowB ? rowA < rowB : chunkColOf(a) < chunkColOf(b);
+        });
+
+        size_t bandBegin = 0;
+        while (bandBegin < keys.size()) {
+            size_t bandEnd = bandBegin;
+            while (bandEnd < keys.size() && chunkRowOf(keys[bandEnd]) == chunkRowOf(keys[bandBegin])) bandEnd++;
+            long long baseRow = static_cast<long long>(chunkRowOf(keys[bandBegin])) * CHUNK_SIZE;
+
+            for (int r = 0; r < CHUNK_SIZE; r++) {
+                // A run reaching a chunk's right edge may continue in the next chunk
+                long long runStart = 0, runEnd = 0;
+                bool pending = false;
+                for (size_t k = bandBegin; k < bandEnd; k++) {
+                    uint64_t word = chunks.find(keys[k])->second.rows[r];
+                    long long base = static_cast<long long>(chunkColOf(keys[k])) * CHUNK_SIZE;
+                    while (word) {
+                        int start = __builtin_ctzll(word);
+                        uint64_t rest = ~word >> start;
+                        int length = rest == 0 ? 64 - start : __builtin_ctzll(rest);
+                        if (pending && runEnd == base + start) {
+                            runEnd += length;
+                        } else {
+                            if (pending) sink(baseRow + r, runStart, runEnd - runStart);
+                            runStart = base + start;
+                            runEnd = runStart + length;
+                            pending = true;
+                        }
+                        word = length + start >= 64 ? 0 : word & (~0ULL << (start + length));
+                    }
+                }
+                if (pending) sink(baseRow + r, runStart, runEnd - runStart);
+            }
+            bandBegin = bandEnd;
+        }
+    }
+
+    // Copy the window of the plane whose top-left corner is (top, left) into grid
+    void extract(BitGrid& grid, long long top, long long left) const {
+        grid.clear();
+        long long bottom = top + grid.getRows();
+        long long right = left + grid.getCols();
+        for (const auto& entry : chunks) {
+            long long baseRow = static_cast<long long>(chunkRowOf(entry.first)) * CHUNK_SIZE;
+            long long baseCol = static_cast<long long>(chunkColOf(entry.first)) * CHUNK_SIZE;
+            if (baseRow >= bottom || baseRow + CHUNK_SIZE <= top ||
+                baseCol >= right || baseCol + CHUNK_SIZE <= left) {
+                continue;
+            }
+            for (int r = 0; r < CHUNK_SIZE; r++) {
+                long long row = baseRow + r;
+                if (row < top || row >= bottom) continue;
+                uint64_t word = entry.second.rows[r];
+                while (word) {
+                    int bit = __builtin_ctzll(word);
+                    long long col = baseCol + bit;
+                    if (col >= left && col < right) {
+                        grid.set(static_cast<int>(row - top), static_cast<int>(col - left), true);
+                    }
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+};
+
+#endif // LIFE_SPARSE_UNIVERSE_HPP
@@ -0,0 +1,150 @@
+// Temporally blocked stepping for the bit-packed Life grid
+//
+// A plain step streams the whole board through memory once per generation,
+// so boards larger than the last-level cache are bound by memory bandwidth.
+// Here the torus is cut into tiles of TILE_ROWS rows by TILE_WORDS words.
+// Each tile is copied with a halo of `depth` rows above and below and one word
+// either side into a per-worker scratch grid, advanced `depth` generations
+// there while it stays in L2, and its interior written back: one pass over
+// main memory for every `depth` generations instead of every generation.
+//
+// The cell in the corner of a tile depends on cells up to `depth` away, so the
+// halo is recomputed by neighbouring tiles as well: each generation the
+// correct part of the scratch grid shrinks by one cell on every side, and the
+// rows stepped shrink with it. One halo word covers up to 64 generations, so
+// depth is capped at MAX_DEPTH and longer runs take several passes. The
+// scratch grid holds the torus unrolled around the tile, so boards of any
+// size, including ones narrower than a word or shorter than the halo, work.
+//
+// Every tile reads the unmodified source and writes its own rectangle of the
+// destination, which keeps the result identical to stepping one generation at
+// a time, for any thread count and any Life-like rule.
+
+#ifndef LIFE_TEMPORAL_BLOCKING_HPP
+#define LIFE_TEMPORAL_BLOCKING_HPP
+
+#include "simd_kernels.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class TemporalBlocker {
+public:
+    static const int TILE_ROWS = 512;
+    static const int TILE_WORDS = 64;
+    static const int MAX_DEPTH = 32;   // Generations per pass; at most 64 with one halo word
+
+    // Boards smaller than this (in words) already stay in cache between
+    // generations, where the recomputed halo makes blocking slower than
+    // stepping one generation at a time
+    static const std::size_t MIN_WORDS = 1 << 20;
+
+private:
+    // Two scratch grids per worker, sized for the largest tile and halo
+    std::vector<std::pair<BitGrid, BitGrid>> scratchByWorker;
+
+    // 64 cells of a row starting at column c, continuing past the last column
+    // from column 0 as the torus does
+    static uint64_t window(const BitGrid& grid, const uint64_t* row, int c) {
+        if ((c & 63) == 0 && grid.getCols() - c >= 64) {
+            return row[c >> 6];
+        }
+        uint64_t bits = 0;
+        for (int filled = 0; filled < 64; c = 0) {
+            int w = c >> 6;
+            int offset = c & 63;
+            uint64_t piece = row[w] >> offset;
+            if (offset != 0 && w + 1 < grid.getWordsPerRow()) {
+                piece |= row[w + 1] << (64 - offset);
+            }
+            int take = std::min(64 - filled, grid.getCols() - c);  // Cells before the row wraps
+            if (take < 64) {
+                piece &= (1ULL << take) - 1;
+            }
+            bits |= piece << filled;
+            filled += take;
+        }
+        return bits;
+    }
+
+    // Advance one tile depth generations from source into target
+    static void stepTile(const BitGrid& source, BitGrid& target, int firstRow, int firstWord, int depth,
+                         const life::RuleKernel& kernel, BitGrid& a, BitGrid& b) {
+        const int rows = source.getRows();
+        const int cols = source.getCols();
+        const int tileRows = std::min(TILE_ROWS, rows - firstRow);
+        const int tileWords = std::min(TILE_WORDS, source.getWordsPerRow() - firstWord);
+        const int height = tileRows + 2 * depth;
+        const int width = tileWords + 2;
+
+        // Load the tile and its halo; scratch column 0 is board column (firstWord - 1) * 64
+        long long startCol = (static_cast<long long>(firstWord) - 1) * 64;
+        for (int i = 0; i < height; i++) {
+            int r = static_cast<int>(((static_cast<long long>(firstRow) - depth + i) % rows + rows) % rows);
+            const uint64_t* from = source.row(r);
+            uint64_t* to = a.row(i);
+            for (int w = 0; w < width; w++) {
+                long long c = startCol + 64LL * w;
+                to[w] = c >= 0 && c + 64 <= cols ? from[c >> 6]
+                                                 : window(source, from, static_cast<int>((c % cols + cols) % cols));
+            }
+        }
+
+        // Rows outside the shrinking correct region are no longer stepped
+        BitGrid* current = &a;
+        BitGrid* next = &b;
+        for (int g = 0; g < depth; g++) {
+            kernel(*current, *next, g + 1, height - g - 1, 0, width);
+            std::swap(current, next);
+        }
+
+        const uint64_t lastMask = source.lastWordMask();
+        const int lastWord = source.getWordsPerRow() - 1;
+        for (int i = 0; i < tileRows; i++) {
+            const uint64_t* from = current->row(depth + i) + 1;
+            uint64_t* to = target.row(firstRow + i) + firstWord;
+            for (int w = 0; w < tileWords; w++) {
+                to[w] = firstWord + w == lastWord ? from[w] & lastMask : from[w];
+            }
+        }
+    }
+
+public:
+    // Advance grid by generations under kernel; spare must have the same
+    // dimensions and is left holding an earlier generation
+    void advance(BitGrid& grid, BitGrid& spare, int generations, ThreadPool* pool, const life::RuleKernel& kernel) {
+        if (grid.getRows() == 0 || grid.getCols() == 0) {
+            return;
+        }
+        int workers = pool ? pool->getThreadCount() : 1;
+        if (static_cast<int>(scratchByWorker.size()) < workers) {
+            BitGrid scratch(TILE_ROWS + 2 * MAX_DEPTH, (TILE_WORDS + 2) * 64);
+            scratchByWorker.resize(workers, std::make_pair(scratch, scratch));
+        }
+
+        const int rowTiles = (grid.getRows() + TILE_ROWS - 1) / TILE_ROWS;
+        const int wordTiles = (grid.getWordsPerRow() + TILE_WORDS - 1) / TILE_WORDS;
+        while (generations > 0) {
+            int depth = std::min(generations, MAX_DEPTH);
+            auto task = [&](int tile, int worker) {
+                std::pair<BitGrid, BitGrid>& scratch = scratchByWorker[worker];
+                stepTile(grid, spare, (tile / wordTiles) * TILE_ROWS, (tile % wordTiles) * TILE_WORDS, depth,
+                         kernel, scratch.first, scratch.second);
+            };
+            if (pool) {
+                pool->parallelFor(rowTiles * wordTiles, task);
+            } else {
+                for (int tile = 0; tile < rowTiles * wordTiles; tile++) {
+                    task(tile, 0);
+                }
+            }
+            std::swap(grid, spare);
+            generations -= depth;
+        }
+    }
+};
+
+#endif // LIFE_TEMPORAL_BLOCKING_HPP
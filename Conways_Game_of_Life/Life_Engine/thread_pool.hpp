@@ -0,0 +1,134 @@
+// Persistent worker pool for splitting a generation across cores
+//
+// Workers are started once and sleep on a condition variable between jobs,
+// so a generation only pays for a wake-up rather than thread creation. The
+// calling thread takes part in every job as worker 0.
+
+#ifndef LIFE_THREAD_POOL_HPP
+#define LIFE_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    // Task index in [0, taskCount) and the index of the worker running it
+    using Task = std::function<void(int task, int worker)>;
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const Task* job;
+    int taskCount;
+    std::atomic<int> nextTask;
+    int busyWorkers;
+    uint64_t epoch;
+    bool stopping;
+
+    void runTasks(int worker) {
+        int task;
+        while ((task = nextTask.fetch_add(1)) < taskCount) {
+            (*job)(task, worker);
+        }
+    }
+
+    void workerLoop(int worker) {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || epoch != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = epoch;
+            }
+            runTasks(worker);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busyWorkers == 0) {
+                done.notify_one();
+            }
+        }
+    }
+
+    void start(int threads) {
+        if (threads <= 0) {
+            threads = static_cast<int>(std::thread::hardware_concurrency());
+        }
+        if (threads <= 0) {
+            threads = 1;
+        }
+        stopping = false;
+        for (int i = 1; i < threads; i++) {
+            workers.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+    }
+
+public:
+    // threads <= 0 uses one thread per hardware core
+    explicit ThreadPool(int threads = 0)
+        : job(nullptr), taskCount(0), nextTask(0), busyWorkers(0), epoch(0), stopping(false) {
+        start(threads);
+    }
+
+    ~ThreadPool() { stop(); }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of threads that run tasks, including the caller
+    int getThreadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+    void setThreadCount(int threads) {
+        stop();
+        start(threads);
+    }
+
+    // Run fn for every task index and return once all of them have finished.
+    // Tasks are handed out dynamically, so fn must not depend on which worker
+    // runs which task for anything but scratch space.
+    void parallelFor(int tasks, const Task& fn) {
+        if (workers.empty() || tasks <= 1) {
+            for (int task = 0; task < tasks; task++) {
+                fn(task, 0);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &fn;
+            taskCount = tasks;
+            nextTask = 0;
+            busyWorkers = static_cast<int>(workers.size());
+            epoch++;
+        }
+        wake.notify_all();
+        runTasks(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return busyWorkers == 0; });
+        job = nullptr;
+    }
+};
+
+#endif // LIFE_THREAD_POOL_HPP
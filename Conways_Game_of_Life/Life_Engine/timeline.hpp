@@ -0,0 +1,554 @@
+// Reversible history of a BitGrid run, stored as XOR deltas with keyframes
+//
+// Each recorded generation is kept as the XOR of its words with the previous
+// generation's: only words that changed are stored, as a varint gap from the
+// last changed word followed by the 64-bit XOR. Since XOR undoes itself, the
+// same delta steps forward or back, and a step in either direction touches
+// only the words that changed.
+//
+// Deltas are grouped into segments, each opening with a keyframe: the whole
+// grid coded the same way against an empty board. A new segment starts once
+// the current one's deltas outweigh its keyframe (or after
+// MAX_SEGMENT_GENERATIONS), so keyframes never cost more than the deltas they
+// cover. Memory therefore follows the amount of change, not generations times
+// grid size, and seeking costs at most one keyframe plus one segment of
+// deltas. Once the history exceeds its byte budget the oldest segments are
+// dropped.
+//
+// The timeline keeps its own copy of the grid at the cursor, so recording a
+// generation only needs the new grid, and generations skipped by a jump are
+// simply one larger step. Recording after stepping back replaces the
+// recorded future, unless the new generation matches it.
+//
+// Replay files (.replay) hold the segments exactly as stored, behind a header
+// with the dimensions and rule; every section is in host byte order.
+
+#ifndef LIFE_TIMELINE_HPP
+#define LIFE_TIMELINE_HPP
+
+#include "bit_grid.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace life {
+
+const char REPLAY_MAGIC[8] = {'L', 'I', 'F', 'E', 'P', 'L', 'A', 'Y'};
+const uint32_t REPLAY_VERSION = 1;
+const uint32_t REPLAY_BYTE_ORDER = 0x01020304;
+
+struct ReplayHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    int32_t rows;
+    int32_t cols;
+    uint64_t segmentCount;
+    char rule[32];          // NUL-terminated rule string, e.g. "B3/S23"
+};
+static_assert(sizeof(ReplayHeader) == 64, "replay header layout must not depend on the compiler");
+
+struct ReplaySegment {
+    int64_t firstGeneration;
+    uint64_t keyframeBytes;
+    uint64_t deltaBytes;
+    uint64_t entries;       // Followed by the keyframe, the deltas and one uint32_t end offset per entry
+};
+static_assert(sizeof(ReplaySegment) == 32, "replay segment layout must not depend on the compiler");
+
+// Whether a file name has the replay extension (.replay)
+inline bool isReplayFile(const std::string& filename) {
+    std::string::size_type dot = filename.rfind('.');
+    return dot != std::string::npos && filename.compare(dot, std::string::npos, ".replay") == 0;
+}
+
+} // namespace life
+
+class Timeline {
+public:
+    static const int MAX_SEGMENT_GENERATIONS = 1024;
+    static const std::size_t MIN_KEYFRAME_SPACING = 4096;       // Delta bytes a segment may always hold
+    static const std::size_t DEFAULT_BUDGET = std::size_t(256) << 20;
+
+    // How a move changed the grid it was applied to
+    struct Change {
+        int population;  // Live cells gained
+        uint64_t hash;   // XOR into life::hashGrid
+    };
+
+private:
+    struct Segment {
+        long long firstGeneration;
+        std::vector<uint8_t> keyframe;
+        std::vector<uint8_t> deltas;  // Entry i: varint generation step, then (varint gap, XOR word) pairs
+        std::vector<uint32_t> ends;   // End of entry i in deltas; entry 0 is the step into the keyframe
+    };
+
+    std::deque<Segment> segments;
+    BitGrid tip;            // The grid at the cursor
+    int cursorSegment;      // Index into segments, -1 when nothing is recorded
+    int cursorEntry;
+    long long cursorGeneration;
+    std::size_t bytes;      // Stored bytes of every segment
+    std::size_t budget;
+    std::vector<uint8_t> scratch;
+
+    static void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint64_t getVarint(const uint8_t*& in) {
+        uint64_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            uint8_t byte = *in++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (byte < 0x80) return value;
+        }
+    }
+
+    // Append the words where from and to differ, updating from to match to
+    static void appendDiff(uint64_t* from, const uint64_t* to, std::size_t count, std::vector<uint8_t>& out) {
+        std::size_t next = 0;  // Index after the last word written
+        for (std::size_t i = 0; i < count; i++) {
+            uint64_t diff = from[i] ^ to[i];
+            if (diff == 0) continue;
+            putVarint(out, i - next);
+            uint8_t word[8];
+            std::memcpy(word, &diff, sizeof(diff));
+            out.insert(out.end(), word, word + 8);
+            from[i] = to[i];
+            next = i + 1;
+        }
+    }
+
+    // XOR coded pairs into grid and tip; grid's population and hash change is
+    // added to change
+    static void applyPairs(const uint8_t* in, const uint8_t* end, uint64_t* grid, uint64_t* tip, Change& change) {
+        std::size_t index = 0;
+        while (in < end) {
+            index += getVarint(in);
+            uint64_t diff;
+            std::memcpy(&diff, in, sizeof(diff));
+            in += sizeof(diff);
+            uint64_t before = grid[index];
+            uint64_t after = before ^ diff;
+            grid[index] = after;
+            tip[index] ^= diff;
+            change.population += __builtin_popcountll(after) - __builtin_popcountll(before);
+            change.hash ^= life::hashWord(before, index) ^ life::hashWord(after, index);
+            index++;
+        }
+    }
+
+    // XOR coded pairs into tip only
+    static void applyPairs(const uint8_t* in, const uint8_t* end, uint64_t* tip) {
+        std::size_t index = 0;
+        while (in < end) {
+            index += getVarint(in);
+            uint64_t diff;
+            std::memcpy(&diff, in, sizeof(diff));
+            in += sizeof(diff);
+            tip[index++] ^= diff;
+        }
+    }
+
+    std::size_t segmentBytes(const Segment& segment) const {
+        return segment.keyframe.size() + segment.deltas.size() + segment.ends.size() * sizeof(uint32_t);
+    }
+
+    const uint8_t* entryBegin(const Segment& segment, int entry) const {
+        return segment.deltas.data() + (entry == 0 ? 0 : segment.ends[entry - 1]);
+    }
+
+    const uint8_t* entryEnd(const Segment& segment, int entry) const {
+        return segment.deltas.data() + segment.ends[entry];
+    }
+
+    // Generation step into an entry, and where its pairs start
+    long long entryStep(const Segment& segment, int entry, const uint8_t** pairs) const {
+        const uint8_t* in = entryBegin(segment, entry);
+        long long step = static_cast<long long>(getVarint(in));
+        if (pairs) *pairs = in;
+        return step;
+    }
+
+    // Apply the delta of (segment, entry) to grid and tip
+    void applyEntry(int segment, int entry, BitGrid& grid, Change& change) {
+        const uint8_t* pairs;
+        entryStep(segments[segment], entry, &pairs);
+        applyPairs(pairs, entryEnd(segments[segment], entry), grid.data(), tip.data(), change);
+    }
+
+    bool forward(BitGrid& grid, Change& change) {
+        int segment = cursorSegment;
+        int entry = cursorEntry + 1;
+        if (entry == static_cast<int>(segments[segment].ends.size())) {
+            if (segment + 1 == static_cast<int>(segments.size())) {
+                return false;
+            }
+            segment++;
+            entry = 0;
+        }
+        applyEntry(segment, entry, grid, change);
+        cursorGeneration += entryStep(segments[segment], entry, nullptr);
+        cursorSegment = segment;
+        cursorEntry = entry;
+        return true;
+    }
+
+    bool backward(BitGrid& grid, Change& change) {
+        if (cursorSegment == 0 && cursorEntry == 0) {
+            return false;  // The oldest generation kept
+        }
+        applyEntry(cursorSegment, cursorEntry, grid, change);
+        cursorGeneration -= entryStep(segments[cursorSegment], cursorEntry, nullptr);
+        if (cursorEntry == 0) {
+            cursorSegment--;
+            cursorEntry = static_cast<int>(segments[cursorSegment].ends.size()) - 1;
+        } else {
+            cursorEntry--;
+        }
+        return true;
+    }
+
+    // Position of an entry in a stream of every delta, for comparing seek routes
+    long long streamOffset(int segment, int entry) const {
+        long long offset = 0;
+        for (int s = 0; s < segment; s++) {
+            offset += static_cast<long long>(segments[s].deltas.size());
+        }
+        return offset + segments[segment].ends[entry];
+    }
+
+    void startSegment(long long generation, const BitGrid& grid) {
+        segments.emplace_back();
+        Segment& segment = segments.back();
+        segment.firstGeneration = generation;
+        std::vector<uint64_t> empty(grid.wordCount(), 0);
+        appendDiff(empty.data(), grid.data(), grid.wordCount(), segment.keyframe);
+        bytes += segment.keyframe.size();
+    }
+
+    // Drop the recorded generations after the cursor
+    void truncate() {
+        while (static_cast<int>(segments.size()) > cursorSegment + 1) {
+            bytes -= segmentBytes(segments.back());
+            segments.pop_back();
+        }
+        Segment& segment = segments[cursorSegment];
+        bytes -= segmentBytes(segment);
+        segment.ends.resize(cursorEntry + 1);
+        segment.deltas.resize(segment.ends.back());
+        bytes += segmentBytes(segment);
+    }
+
+    void enforceBudget() {
+        while (bytes > budget && cursorSegment > 0) {
+            bytes -= segmentBytes(segments.front());
+            segments.pop_front();
+            cursorSegment--;
+        }
+    }
+
+public:
+    Timeline() : cursorSegment(-1), cursorEntry(0), cursorGeneration(0), bytes(0), budget(DEFAULT_BUDGET) {}
+
+    void setBudget(std::size_t maxBytes) {
+        budget = maxBytes;
+        enforceBudget();
+    }
+
+    bool isEmpty() const { return cursorSegment < 0; }
+    long long getGeneration() const { return cursorGeneration; }
+    std::size_t getByteSize() const { return bytes; }
+
+    long long getFirstGeneration() const { return isEmpty() ? 0 : segments.front().firstGeneration; }
+    long long getLastGeneration() const {
+        if (isEmpty()) return 0;
+        long long generation = segments.back().firstGeneration;
+        for (int e = 1; e < static_cast<int>(segments.back().ends.size()); e++) {
+            generation += entryStep(segments.back(), e, nullptr);
+        }
+        return generation;
+    }
+
+    const BitGrid& getGrid() const { return tip; }
+
+    void clear() {
+        segments.clear();
+        cursorSegment = -1;
+        cursorEntry = 0;
+        cursorGeneration = 0;
+        bytes = 0;
+        tip = BitGrid();
+    }
+
+    // Forget everything and start recording from grid at generation
+    void start(const BitGrid& grid, long long generation) {
+        clear();
+        tip = grid;
+        startSegment(generation, grid);
+        Segment& segment = segments.back();
+        putVarint(segment.deltas, 0);
+        segment.ends.push_back(static_cast<uint32_t>(segment.deltas.size()));
+        bytes += segment.deltas.size() + sizeof(uint32_t);
+        cursorSegment = 0;
+        cursorEntry = 0;
+        cursorGeneration = generation;
+    }
+
+    // Record grid as the generation after the cursor. If generations were
+    // recorded past the cursor they are kept when grid matches the next one
+    // and replaced otherwise.
+    void record(const BitGrid& grid, long long generation) {
+        if (isEmpty() || generation <= cursorGeneration || grid.getRows() != tip.getRows() ||
+            grid.getCols() != tip.getCols()) {
+            start(grid, generation);
+            return;
+        }
+
+        scratch.clear();
+        putVarint(scratch, static_cast<uint64_t>(generation - cursorGeneration));
+        bool ahead = cursorEntry + 1 < static_cast<int>(segments[cursorSegment].ends.size()) ||
+                     cursorSegment + 1 < static_cast<int>(segments.size());
+        appendDiff(tip.data(), grid.data(), grid.wordCount(), scratch);
+
+        if (ahead) {
+            int segment = cursorSegment;
+            int entry = cursorEntry + 1;
+            if (entry == static_cast<int>(segments[segment].ends.size())) {
+                segment++;
+                entry = 0;
+            }
+            const uint8_t* begin = entryBegin(segments[segment], entry);
+            const uint8_t* end = entryEnd(segments[segment], entry);
+            if (static_cast<std::size_t>(end - begin) == scratch.size() && std::equal(begin, end, scratch.begin())) {
+                cursorSegment = segment;
+                cursorEntry = entry;
+                cursorGeneration = generation;
+                return;
+            }
+            truncate();
+        }
+
+        Segment* segment = &segments[cursorSegment];
+        std::size_t deltaBytes = segment->deltas.size() - segment->ends[0];
+        std::size_t spacing = MIN_KEYFRAME_SPACING;
+        if (static_cast<int>(segment->ends.size()) >= MAX_SEGMENT_GENERATIONS ||
+            deltaBytes >= std::max(segment->keyframe.size(), spacing)) {
+            startSegment(generation, grid);
+            segment = &segments.back();
+            cursorSegment++;
+            cursorEntry = -1;
+        }
+        segment->deltas.insert(segment->deltas.end(), scratch.begin(), scratch.end());
+        segment->ends.push_back(static_cast<uint32_t>(segment->deltas.size()));
+        bytes += scratch.size() + sizeof(uint32_t);
+        cursorEntry++;
+        cursorGeneration = generation;
+        enforceBudget();
+    }
+
+    // Move grid, which must equal getGrid(), one recorded generation back or
+    // forward. False at either end of the timeline.
+    bool stepBack(BitGrid& grid, Change& change) {
+        change.population = 0;
+        change.hash = 0;
+        return !isEmpty() && backward(grid, change);
+    }
+
+    bool stepForward(BitGrid& grid, Change& change) {
+        change.population = 0;
+        change.hash = 0;
+        return !isEmpty() && forward(grid, change);
+    }
+
+    // Move grid, which must equal getGrid(), to the last recorded generation
+    // at or before generation (the first one if it is earlier). Walks the
+    // deltas from the cursor or from the target's keyframe, whichever is
+    // fewer bytes. Returns the generation reached, -1 if nothing is recorded.
+    long long seek(BitGrid& grid, long long generation) {
+        if (isEmpty()) {
+            return -1;
+        }
+        // The segment, then the entry, holding the target
+        int segment = 0;
+        while (segment + 1 < static_cast<int>(segments.size()) && segments[segment + 1].firstGeneration <= generation) {
+            segment++;
+        }
+        int entry = 0;
+        long long reached = segments[segment].firstGeneration;
+        for (int e = 1; e < static_cast<int>(segments[segment].ends.size()); e++) {
+            long long next = reached + entryStep(segments[segment], e, nullptr);
+            if (next > generation) break;
+            reached = next;
+            entry = e;
+        }
+
+        Change change = {0, 0};
+        long long walk = streamOffset(segment, entry) - streamOffset(cursorSegment, cursorEntry);
+        long long fromKeyframe = static_cast<long long>(segments[segment].keyframe.size()) +
+                                 segments[segment].ends[entry] - segments[segment].ends[0];
+        if (std::abs(walk) > fromKeyframe) {
+            grid.clear();
+            tip.clear();
+            applyPairs(segments[segment].keyframe.data(),
+                       segments[segment].keyframe.data() + segments[segment].keyframe.size(),
+                       grid.data(), tip.data(), change);
+            cursorSegment = segment;
+            cursorEntry = 0;
+            cursorGeneration = segments[segment].firstGeneration;
+        }
+        while (cursorSegment > segment || (cursorSegment == segment && cursorEntry > entry)) {
+            backward(grid, change);
+        }
+        while (cursorSegment < segment || (cursorSegment == segment && cursorEntry < entry)) {
+            forward(grid, change);
+        }
+        return cursorGeneration;
+    }
+
+    // Write every recorded generation to a .replay file
+    bool write(const std::string& path, const std::string& rule, std::string& error) const {
+        if (isEmpty()) {
+            error = "nothing has been recorded";
+            return false;
+        }
+        life::ReplayHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, life::REPLAY_MAGIC, sizeof(header.magic));
+        header.version = life::REPLAY_VERSION;
+        header.byteOrder = life::REPLAY_BYTE_ORDER;
+        header.rows = tip.getRows();
+        header.cols = tip.getCols();
+        header.segmentCount = segments.size();
+        std::strncpy(header.rule, rule.c_str(), sizeof(header.rule) - 1);
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            error = "cannot open " + path + " for writing";
+            return false;
+        }
+        bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+        for (const Segment& segment : segments) {
+            life::ReplaySegment entry;
+            entry.firstGeneration = segment.firstGeneration;
+            entry.keyframeBytes = segment.keyframe.size();
+            entry.deltaBytes = segment.deltas.size();
+            entry.entries = segment.ends.size();
+            ok = ok && std::fwrite(&entry, sizeof(entry), 1, file) == 1
+                    && std::fwrite(segment.keyframe.data(), 1, segment.keyframe.size(), file) == segment.keyframe.size()
+                    && std::fwrite(segment.deltas.data(), 1, segment.deltas.size(), file) == segment.deltas.size()
+                    && std::fwrite(segment.ends.data(), sizeof(uint32_t), segment.ends.size(), file) == segment.ends.size();
+        }
+        ok = std::fclose(file) == 0 && ok;
+        if (!ok) {
+            error = "failed writing " + path;
+        }
+        return ok;
+    }
+
+    // Replace the timeline with a .replay file, with the cursor on its first
+    // generation; getGrid() then holds that generation
+    bool read(const std::string& path, std::string& rule, std::string& error) {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            error = "cannot open " + path;
+            return false;
+        }
+        life::ReplayHeader header;
+        bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+                  std::memcmp(header.magic, life::REPLAY_MAGIC, sizeof(header.magic)) == 0;
+        if (ok && (header.version != life::REPLAY_VERSION || header.byteOrder != life::REPLAY_BYTE_ORDER)) {
+            error = "replay was written by an incompatible version or byte order";
+            std::fclose(file);
+            return false;
+        }
+        ok = ok && header.rows > 0 && header.cols > 0 && header.segmentCount > 0;
+
+        std::deque<Segment> loaded;
+        std::size_t words = static_cast<std::size_t>(header.rows) * ((header.cols + 63) / 64);
+        for (uint64_t s = 0; ok && s < header.segmentCount; s++) {
+            life::ReplaySegment entry;
+            ok = std::fread(&entry, sizeof(entry), 1, file) == 1 && entry.entries > 0 &&
+                 entry.entries <= MAX_SEGMENT_GENERATIONS && entry.keyframeBytes <= words * 18 &&
+                 entry.deltaBytes <= entry.entries * words * 18 + entry.entries * 10;
+            if (!ok) break;
+            loaded.emplace_back();
+            Segment& segment = loaded.back();
+            segment.firstGeneration = entry.firstGeneration;
+            segment.keyframe.resize(entry.keyframeBytes);
+            segment.deltas.resize(entry.deltaBytes);
+            segment.ends.resize(entry.entries);
+            ok = std::fread(segment.keyframe.data(), 1, segment.keyframe.size(), file) == segment.keyframe.size() &&
+                 std::fread(segment.deltas.data(), 1, segment.deltas.size(), file) == segment.deltas.size() &&
+                 std::fread(segment.ends.data(), sizeof(uint32_t), segment.ends.size(), file) == segment.ends.size() &&
+                 std::is_sorted(segment.ends.begin(), segment.ends.end()) && segment.ends.back() == entry.deltaBytes &&
+                 validPairs(segment.keyframe.data(), segment.keyframe.data() + segment.keyframe.size(), words, false);
+            for (uint64_t e = 0; ok && e < entry.entries; e++) {
+                const uint8_t* begin = segment.deltas.data() + (e == 0 ? 0 : segment.ends[e - 1]);
+                ok = validPairs(begin, segment.deltas.data() + segment.ends[e], words, true);
+            }
+        }
+        std::fclose(file);
+        if (!ok) {
+            error = "replay file is truncated or corrupt";
+            return false;
+        }
+
+        clear();
+        segments.swap(loaded);
+        for (const Segment& segment : segments) {
+            bytes += segmentBytes(segment);
+        }
+        header.rule[sizeof(header.rule) - 1] = '\0';
+        rule = header.rule;
+        tip = BitGrid(header.rows, header.cols);
+        applyPairs(segments[0].keyframe.data(), segments[0].keyframe.data() + segments[0].keyframe.size(),
+                   tip.data());
+        cursorSegment = 0;
+        cursorEntry = 0;
+        cursorGeneration = segments[0].firstGeneration;
+        return true;
+    }
+
+private:
+    // Whether coded pairs stay inside a grid of words words, after a leading
+    // generation step for deltas
+    static bool validPairs(const uint8_t* in, const uint8_t* end, std::size_t words, bool delta) {
+        auto varint = [&](uint64_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (in == end) return false;
+                uint8_t byte = *in++;
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (byte < 0x80) return true;
+            }
+            return false;
+        };
+        uint64_t value;
+        if (delta && !varint(value)) {
+            return false;
+        }
+        uint64_t index = 0;
+        while (in < end) {
+            if (!varint(value) || value >= words - index || end - in < 8) {
+                return false;
+            }
+            index += value + 1;
+            in += 8;
+        }
+        return true;
+    }
+};
+
+#endif // LIFE_TIMELINE_HPP
@@ -0,0 +1,267 @@
+// Incremental win-condition engine fed by per-generation deltas
+//
+// Conditions are registered once under a small integer id (an enum value of
+// the game) and kept in flat arrays indexed by it; nothing is looked up by
+// name while the game runs. Each generation the game hands over a
+// GenerationDelta - the population, how many cells changed and the grid hash
+// - which the game's kernel already produces, so no grid is rescanned.
+//
+// Conditions are grouped by what they watch, and each group is sorted by its
+// threshold:
+//  - generation goals: reached once the generation count gets there
+//  - still goals: the board unchanged for n generations in a row (no changed
+//    cells, or the same hash when the kernel does not count changes)
+//  - population goals: the population inside [low, high] for n generations
+//    in a row; goals sharing a range share one streak counter
+//  - event goals: raised by the game, e.g. when the census names an object
+// A group keeps one streak and an index of its first unmet goal, so a
+// generation costs a comparison per group however many goals it holds, and a
+// goal met is never looked at again.
+//
+// SlidingWindow keeps the last N values of a series in a fixed ring with a
+// running sum and monotonic min/max queues: push, mean, min and max are all
+// O(1) (amortised for min/max) and nothing is ever shifted.
+
+#ifndef LIFE_WIN_CONDITIONS_HPP
+#define LIFE_WIN_CONDITIONS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace life {
+
+// What one generation changed, as reported by the kernel that computed it
+struct GenerationDelta {
+    int generation;
+    int population;
+    int changedCells;   // Cells that differ from the previous generation, -1 if unknown
+    uint64_t hash;      // life::hashGrid of the new generation
+};
+
+} // namespace life
+
+// The last capacity values of a series, with O(1) sum, mean, min and max
+class SlidingWindow {
+private:
+    // Ring of (position, value) pairs whose values only rise (minimum queue)
+    // or only fall (maximum queue) from front to back
+    struct MonotonicQueue {
+        std::vector<std::pair<long long, int>> items;
+        std::size_t front = 0;
+        std::size_t count = 0;
+
+        std::pair<long long, int>& at(std::size_t i) { return items[(front + i) % items.size()]; }
+        const std::pair<long long, int>& at(std::size_t i) const { return items[(front + i) % items.size()]; }
+
+        // Drop entries that can no longer be the extreme, then append
+        template <typename Beats>
+        void push(long long position, int value, Beats beats) {
+            while (count > 0 && !beats(at(count - 1).second, value)) {
+                count--;
+            }
+            at(count++) = std::make_pair(position, value);
+        }
+
+        void expire(long long oldest) {
+            while (count > 0 && at(0).first < oldest) {
+                front = (front + 1) % items.size();
+                count--;
+            }
+        }
+    };
+
+    std::vector<int> values;
+    std::size_t head;       // Slot of the next value
+    std::size_t filled;
+    long long pushed;       // Values pushed since the last clear
+    long long sum;
+    MonotonicQueue lows;
+    MonotonicQueue highs;
+
+public:
+    explicit SlidingWindow(std::size_t capacity) : values(std::max<std::size_t>(capacity, 1)) {
+        lows.items.resize(values.size());
+        highs.items.resize(values.size());
+        clear();
+    }
+
+    void clear() {
+        head = 0;
+        filled = 0;
+        pushed = 0;
+        sum = 0;
+        lows.front = lows.count = 0;
+        highs.front = highs.count = 0;
+    }
+
+    void push(int value) {
+        if (filled == values.size()) {
+            sum -= values[head];
+        } else {
+            filled++;
+        }
+        values[head] = value;
+        head = (head + 1) % values.size();
+        sum += value;
+
+        long long oldest = pushed + 1 - static_cast<long long>(filled);
+        lows.expire(oldest);
+        highs.expire(oldest);
+        lows.push(pushed, value, [](int kept, int added) { return kept < added; });
+        highs.push(pushed, value, [](int kept, int added) { return kept > added; });
+        pushed++;
+    }
+
+    std::size_t size() const { return filled; }
+    std::size_t capacity() const { return values.size(); }
+    bool empty() const { return filled == 0; }
+
+    double mean() const { return filled == 0 ? 0.0 : static_cast<double>(sum) / filled; }
+    int min() const { return filled == 0 ? 0 : lows.at(0).second; }
+    int max() const { return filled == 0 ? 0 : highs.at(0).second; }
+};
+
+class ConditionEngine {
+private:
+    struct Goal {
+        long long threshold;  // Generation, or streak length
+        int id;
+    };
+
+    // Goals waiting on one counter, by threshold; those before next are met
+    struct GoalGroup {
+        std::vector<Goal> goals;
+        std::size_t next = 0;
+
+        void add(long long threshold, int id) {
+            Goal goal = {threshold, id};
+            goals.insert(std::upper_bound(goals.begin(), goals.end(), goal,
+                                          [](const Goal& a, const Goal& b) { return a.threshold < b.threshold; }),
+                         goal);
+        }
+    };
+
+    struct PopulationGroup {
+        int low;
+        int high;
+        long long streak = 0;
+        GoalGroup goals;
+    };
+
+    struct Condition {
+        std::string description;
+        bool achieved = false;
+        int generation = 0;
+    };
+
+    std::vector<Condition> conditions;  // By id
+    GoalGroup generationGoals;
+    GoalGroup stillGoals;
+    long long stillStreak;
+    uint64_t lastHash;
+    bool hasLastHash;
+    std::vector<PopulationGroup> populationGroups;
+    int achievedCount;
+
+    Condition& slot(int id) {
+        if (id >= static_cast<int>(conditions.size())) {
+            conditions.resize(id + 1);
+        }
+        return conditions[id];
+    }
+
+    // Meet every goal of group whose threshold count has reached
+    void advance(GoalGroup& group, long long count, int generation) {
+        while (group.next < group.goals.size() && group.goals[group.next].threshold <= count) {
+            achieve(group.goals[group.next].id, generation);
+            group.next++;
+        }
+    }
+
+public:
+    ConditionEngine() : stillStreak(0), lastHash(0), hasLastHash(false), achievedCount(0) {}
+
+    // Registration: id is the game's enum value for the condition
+    void addGenerationGoal(int id, const std::string& description, int generations) {
+        slot(id).description = description;
+        generationGoals.add(generations, id);
+    }
+
+    void addStillGoal(int id, const std::string& description, int generations) {
+        slot(id).description = description;
+        stillGoals.add(generations, id);
+    }
+
+    void addPopulationGoal(int id, const std::string& description, int low, int high, int generations) {
+        slot(id).description = description;
+        for (PopulationGroup& group : populationGroups) {
+            if (group.low == low && group.high == high) {
+                group.goals.add(generations, id);
+                return;
+            }
+        }
+        populationGroups.emplace_back();
+        populationGroups.back().low = low;
+        populationGroups.back().high = high;
+        populationGroups.back().goals.add(generations, id);
+    }
+
+    // A goal only achieve() can meet
+    void addEventGoal(int id, const std::string& description) {
+        slot(id).description = description;
+    }
+
+    // Forget every met goal and streak, keeping the registrations
+    void reset() {
+        for (Condition& condition : conditions) {
+            condition.achieved = false;
+            condition.generation = 0;
+        }
+        generationGoals.next = 0;
+        stillGoals.next = 0;
+        stillStreak = 0;
+        hasLastHash = false;
+        for (PopulationGroup& group : populationGroups) {
+            group.streak = 0;
+            group.goals.next = 0;
+        }
+        achievedCount = 0;
+    }
+
+    // Feed one generation
+    void update(const life::GenerationDelta& delta) {
+        advance(generationGoals, delta.generation, delta.generation);
+
+        bool still = delta.changedCells < 0 ? hasLastHash && delta.hash == lastHash : delta.changedCells == 0;
+        stillStreak = still ? stillStreak + 1 : 0;
+        lastHash = delta.hash;
+        hasLastHash = true;
+        advance(stillGoals, stillStreak, delta.generation);
+
+        for (PopulationGroup& group : populationGroups) {
+            bool inRange = delta.population >= group.low && delta.population <= group.high;
+            group.streak = inRange ? group.streak + 1 : 0;
+            advance(group.goals, group.streak, delta.generation);
+        }
+    }
+
+    // Mark a goal met; later calls for the same goal are ignored
+    void achieve(int id, int generation) {
+        Condition& condition = slot(id);
+        if (!condition.achieved) {
+            condition.achieved = true;
+            condition.generation = generation;
+            achievedCount++;
+        }
+    }
+
+    bool isAchieved(int id) const { return id < static_cast<int>(conditions.size()) && conditions[id].achieved; }
+    int getAchievedGeneration(int id) const { return conditions[id].generation; }
+    const std::string& getDescription(int id) const { return conditions[id].description; }
+    int getAchievedCount() const { return achievedCount; }
+};
+
+#endif // LIFE_WIN_CONDITIONS_HPP
@@ -9,19 +9,60 @@
 #include <fstream>
 #include <string>
 #include <limits>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <optional>
 #include <SFML/Graphics.hpp>
 #include <variant>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include "../Life_Engine/simd_kernels.hpp"
+#include "../Life_Engine/active_tiles.hpp"
+#include "../Life_Engine/generation_ring.hpp"
+#include "../Life_Engine/fixed_grid.hpp"
+#include "../Life_Engine/density_pyramid.hpp"
+#include "../Life_Engine/parallel_step.hpp"
+#include "../Life_Engine/sparse_universe.hpp"
+#include "../Life_Engine/hashlife.hpp"
+#include "../Life_Engine/temporal_blocking.hpp"
+#include "../Life_Engine/frame_ring.hpp"
+#include "../Life_Engine/pattern_io.hpp"
+#include "../Life_Engine/snapshot.hpp"
+#include "../Life_Engine/timeline.hpp"
+#include "../Life_Engine/out_of_core.hpp"
+#include "../Life_Engine/distributed.hpp"
+#include "../Life_Engine/instrumentation.hpp"
+#include "../Life_Engine/census.hpp"
+#include "../../Terminal_Renderer/terminal_renderer.hpp"
 using namespace std;
 
 // Game configuration constants
 const int DEFAULT_ROWS = 20;
 const int DEFAULT_COLS = 40;
+const long long MAX_TORUS_CELLS = 1LL << 28;  // 32 MB a board; the generation ring keeps eight
+const int MAX_VIEWPORT_SIZE = 100;  // Infinite-plane viewport, re-extracted for the console every generation
 const int MAX_GENERATIONS = 1000;
+const int PATTERN_CREATION_GENERATIONS = 50;   // Fixed targets of the menu's game modes
+const int POPULATION_TARGET_GENERATIONS = 100;
+const int POPULATION_TARGET_MIN = 20;          // Population range POPULATION_TARGET must end in
+const int POPULATION_TARGET_MAX = 30;
 const int DISPLAY_DELAY_MS = 500;
+const int RENDER_INTERVAL_MS = 100;  // Auto-run redraw period; generations in between are skipped
+const int FRAME_RING_SIZE = 4;  // Generations the simulation thread can run ahead of the display
 const int CELL_SIZE = 20;  // Size of each cell in pixels
 const int WINDOW_PADDING = 50;  // Padding around the grid
 const int TEXT_HEIGHT = 120;  // Height reserved for text instructions
 const int GRID_BORDER = 2;  // Border around the grid
+const int MAX_GRID_VIEW_WIDTH = 1200;  // Largest board area in pixels; bigger boards start zoomed out
+const int MAX_GRID_VIEW_HEIGHT = 800;
+const float MAX_CELL_PIXELS = 64;  // Furthest zoom in
+const float MIN_LINE_CELL_PIXELS = 4;  // Cell borders are hidden below this size
+const float ZOOM_STEP = 1.25f;  // View size factor per wheel notch or key press
+const float PAN_STEP = 0.1f;  // Fraction of the view moved per arrow key press
 
 // Game states enum
 enum class GameMode {
@@ -32,56 +73,95 @@ enum class GameMode {
     TIME_ATTACK
 };
 
+const int GAME_MODE_COUNT = 5;
+
+// Generation kernels available to the engine
+enum class EvolveKernel {
+    SCALAR,  // Per-cell neighbor counting (reference implementation)
+    PACKED,  // 64 cells per word with bitwise full-adder logic, SIMD-dispatched at runtime
+    ACTIVE_TILES  // PACKED, but only recomputing tiles whose neighbourhood changed
+};
+
+// Shape of the universe the engine simulates
+enum class Topology {
+    TORUS,          // Fixed-size board whose edges wrap around
+    INFINITE_PLANE  // Unbounded plane; the board is a viewport onto it
+};
+
+// Whether a board at generation with liveCells cells, in a cycle of
+// cyclePeriod (0 if none) and holding a glider or not, wins a game of mode
+// played to target generations
+bool winsGameMode(GameMode mode, int target, int generation, int liveCells, int cyclePeriod, bool hasGlider) {
+    switch (mode) {
+        case GameMode::STABILITY_GOAL:
+            // Still lifes are period 1; oscillators up to the ring depth also count
+            return generation > 0 && cyclePeriod > 0;
+        case GameMode::SURVIVAL_GOAL:
+            return generation >= target;
+        case GameMode::POPULATION_TARGET:
+            return liveCells >= POPULATION_TARGET_MIN && liveCells <= POPULATION_TARGET_MAX && generation >= target;
+        case GameMode::PATTERN_CREATION:
+            return hasGlider;
+        default:
+            return false;
+    }
+}
+
+bool losesGameMode(GameMode mode, int liveCells) {
+    switch (mode) {
+        case GameMode::SURVIVAL_GOAL:
+        case GameMode::POPULATION_TARGET:
+        case GameMode::TIME_ATTACK:
+            return liveCells == 0;
+        default:
+            return false;
+    }
+}
+
 // Grid class to encapsulate the game board
+// Cells are bit-packed 64 per word so the engine can evolve a whole word at a time
 class Grid {
 private:
-    vector<vector<bool>> cells;
+    BitGrid cells;
     int rows;
     int cols;
     
 public:
+    // Kernel of the packed generation step, see stepInto()
+    using Kernel = life::RuleKernel;
+    
     // Constructor
-    Grid(int r, int c) : rows(r), cols(c) {
-        cells = vector<vector<bool>>(rows, vector<bool>(cols, false));
-    }
+    Grid(int r, int c) : cells(r, c), rows(r), cols(c) {}
     
     // Getters
     int getRows() const { return rows; }
     int getCols() const { return cols; }
-    bool getCell(int row, int col) const { return cells[row][col]; }
+    bool getCell(int row, int col) const { return cells.get(row, col); }
+    const BitGrid& getBits() const { return cells; }
+    BitGrid& getBits() { return cells; }
     
     // Setters
-    void setCell(int row, int col, bool alive) { cells[row][col] = alive; }
+    void setCell(int row, int col, bool alive) { cells.set(row, col, alive); }
     
     // Grid operations
     void clear() {
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                cells[i][j] = false;
-            }
-        }
+        cells.clear();
     }
     
     void randomFill(double density = 0.3) {
         random_device rd;
         mt19937 gen(rd());
-        uniform_real_distribution<> dis(0.0, 1.0);
-        
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                cells[i][j] = dis(gen) < density;
-            }
-        }
+        life::fillSoup(*this, gen, density);
+    }
+    
+    // The same soup for the same seed, density and dimensions on every machine
+    void randomFill(double density, uint64_t seed) {
+        mt19937 gen = life::soupGenerator(seed);
+        life::fillSoup(*this, gen, density);
     }
     
     int countLiveCells() const {
-        int count = 0;
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                if (cells[i][j]) count++;
-            }
-        }
-        return count;
+        return cells.popcount();
     }
     
     int countLiveNeighbors(int row, int col) const {
@@ -94,7 +174,7 @@ public:
                 int neighborRow = (row + i + rows) % rows; // Periodic boundary conditions
                 int neighborCol = (col + j + cols) % cols;
                 
-                if (cells[neighborRow][neighborCol]) {
+                if (cells.get(neighborRow, neighborCol)) {
                     count++;
                 }
             }
@@ -103,19 +183,14 @@ public:
         return count;
     }
     
-    bool isStable(const Grid& other) const {
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                if (cells[i][j] != other.cells[i][j]) {
-                    return false;
-                }
-            }
-        }
-        return true;
-    }
+    bool operator==(const Grid& other) const { return cells == other.cells; }
+    uint64_t hash() const { return life::hashGrid(cells); }
+    
+    // The board interface of FixedGrid, so puzzle code can run on either
+    static Kernel kernelFor(const life::Rule& rule) { return life::fastRuleKernel(rule); }
     
-    void copyFrom(const Grid& other) {
-        cells = other.cells;
+    void stepInto(Grid& next, const Kernel& kernel) const {
+        kernel(cells, next.cells, 0, rows, 0, cells.getWordsPerRow());
     }
     
     // File operations
@@ -128,7 +203,7 @@ public:
         file << rows << " " << cols << "\n";
         for (int i = 0; i < rows; i++) {
             for (int j = 0; j < cols; j++) {
-                file << (cells[i][j] ? "1" : "0") << " ";
+                file << (cells.get(i, j) ? "1" : "0") << " ";
             }
             file << "\n";
         }
@@ -154,7 +229,7 @@ public:
             for (int j = 0; j < cols; j++) {
                 int value;
                 file >> value;
-                cells[i][j] = (value == 1);
+                cells.set(i, j, value == 1);
             }
         }
         
@@ -164,6 +239,15 @@ public:
 };
 
 // Graphical Manual Setup class
+// The board is drawn through a view that can be panned and zoomed, from a
+// texture covering only the part in view. Zoomed in it holds one texel per
+// visible cell; zoomed out, one texel per block of cells at the density
+// pyramid level whose blocks are about a pixel wide, shaded by how full the
+// block is. The texture and the cell borders are rebuilt only when the view
+// pans or zooms; toggling a cell adjusts the pyramid along one path and
+// repaints the one texel holding it, so a frame costs the same at any board
+// size. The text is built once, with just the live cell count updated when it
+// changes.
 class ManualSetupWindow {
 private:
     sf::RenderWindow window;
@@ -171,13 +255,45 @@ private:
     sf::Font font;
     bool fontLoaded;
     
+    DensityPyramid density;       // Live cells per block, for the zoomed-out levels
+    sf::Texture cellTexture;
+    vector<uint8_t> cellPixels;   // RGBA texels of the visible blocks, uploaded to cellTexture
+    sf::Sprite cellSprite;
+    sf::VertexArray gridLines;    // Borders of the visible cells, once cells are large enough to show them
+    bool viewDirty;               // The view moved since the texture was built
+    int viewLevel;                // Pyramid level the texture shows, 0 for single cells
+    sf::Vector2i viewFirst;       // Block (column, row) of the texture's top-left texel
+    sf::Vector2i viewSize;        // Texels in use, in blocks
+    sf::View gridView;            // Board coordinates, one unit per cell
+    sf::FloatRect gridArea;       // Where the board is shown, in window pixels
+    float fitScale;               // Pixels per cell with the whole board in view
+    bool panning;
+    sf::Vector2i panFrom;
+    
+    sf::RectangleShape titleBar;
+    sf::RectangleShape gridBorder;
+    sf::RectangleShape instructionPanel;
+    vector<sf::Text> labels;      // Text that never changes
+    optional<sf::Text> cellCount;
+    int liveCells;
+    
 public:
-    ManualSetupWindow(Grid& g) : grid(g) {
-        int gridPixelHeight = grid.getRows() * CELL_SIZE + 2 * WINDOW_PADDING + GRID_BORDER * 2;
+    ManualSetupWindow(Grid& g)
+        : grid(g), cellSprite(cellTexture), gridLines(sf::PrimitiveType::Lines), viewDirty(true), viewLevel(0),
+          panning(false), liveCells(g.countLiveCells()) {
+        // Large boards start zoomed out to fit, small ones at full cell size
+        fitScale = std::min({ static_cast<float>(CELL_SIZE),
+                              static_cast<float>(MAX_GRID_VIEW_WIDTH) / grid.getCols(),
+                              static_cast<float>(MAX_GRID_VIEW_HEIGHT) / grid.getRows() });
+        float areaWidth = grid.getCols() * fitScale;
+        float areaHeight = grid.getRows() * fitScale;
+        
+        int gridPixelHeight = static_cast<int>(areaHeight) + 2 * WINDOW_PADDING + GRID_BORDER * 2;
         int minTextHeight = TEXT_HEIGHT + 40; // Extra space for text and padding
         int minWindowHeight = 400; // Minimum window height for small grids
+        int minWindowWidth = 400;
         int windowHeight = std::max(gridPixelHeight + minTextHeight, minWindowHeight);
-        int windowWidth = grid.getCols() * CELL_SIZE + 2 * WINDOW_PADDING + GRID_BORDER * 2;
+        int windowWidth = std::max(static_cast<int>(areaWidth) + 2 * WINDOW_PADDING + GRID_BORDER * 2, minWindowWidth);
         
         // SFML 3.0 uses Vector2u for VideoMode
         window.create(sf::VideoMode(sf::Vector2u(windowWidth, windowHeight)), "Manual Setup - Conway's Game of Life");
@@ -189,11 +305,21 @@ public:
             // Try alternative fonts
             fontLoaded = font.openFromFile("C:/Windows/Fonts/arial.ttf");
         }
+        
+        gridArea = sf::FloatRect(sf::Vector2f(WINDOW_PADDING, WINDOW_PADDING), sf::Vector2f(areaWidth, areaHeight));
+        gridView = sf::View(sf::FloatRect(sf::Vector2f(0, 0), sf::Vector2f(grid.getCols(), grid.getRows())));
+        gridView.setViewport(sf::FloatRect(
+            sf::Vector2f(gridArea.position.x / windowWidth, gridArea.position.y / windowHeight),
+            sf::Vector2f(areaWidth / windowWidth, areaHeight / windowHeight)));
+        
+        density.build(grid.getBits());
+        buildLayout();
     }
     
     bool run() {
         while (window.isOpen()) {
-            if (auto event = window.pollEvent()) {
+            // Drain every pending event so mouse movement never queues up behind frames
+            while (const optional<sf::Event> event = window.pollEvent()) {
                 if (event->is<sf::Event::Closed>()) {
                     window.close();
                     return false;
@@ -201,8 +327,25 @@ public:
                 if (auto mouse = event->getIf<sf::Event::MouseButtonPressed>()) {
                     if (mouse->button == sf::Mouse::Button::Left) {
                         handleMouseClick(mouse->position.x, mouse->position.y);
+                    } else {
+                        panning = true;
+                        panFrom = mouse->position;
+                    }
+                }
+                if (auto mouse = event->getIf<sf::Event::MouseButtonReleased>()) {
+                    if (mouse->button != sf::Mouse::Button::Left) {
+                        panning = false;
                     }
                 }
+                if (auto mouse = event->getIf<sf::Event::MouseMoved>()) {
+                    if (panning) {
+                        panBy(window.mapPixelToCoords(panFrom, gridView) - window.mapPixelToCoords(mouse->position, gridView));
+                        panFrom = mouse->position;
+                    }
+                }
+                if (auto wheel = event->getIf<sf::Event::MouseWheelScrolled>()) {
+                    zoomAt(wheel->position, wheel->delta > 0 ? 1 / ZOOM_STEP : ZOOM_STEP);
+                }
                 if (auto key = event->getIf<sf::Event::KeyPressed>()) {
                     if (key->code == sf::Keyboard::Key::S) {
                         window.close();
@@ -212,6 +355,7 @@ public:
                         window.close();
                         return false;
                     }
+                    handleViewKey(key->code);
                 }
             }
             render();
@@ -220,115 +364,236 @@ public:
     }
     
 private:
+    // Fill the texture with what the view shows and lay out the borders of
+    // the visible cells: one texel per cell when cells are at least a pixel
+    // wide, else one per block of the pyramid level about a pixel wide
+    void buildView() {
+        const int rows = grid.getRows();
+        const int cols = grid.getCols();
+        float scale = pixelsPerCell();
+        int level = 0;
+        while (level < density.getTopLevel() && scale * (1 << (level + 1)) <= 1.0f) {
+            level++;
+        }
+        const int block = 1 << level;
+        
+        // Visible blocks, clamped to the board
+        sf::Vector2f topLeft = gridView.getCenter() - gridView.getSize() / 2.0f;
+        sf::Vector2f bottomRight = topLeft + gridView.getSize();
+        int firstRow = std::clamp(static_cast<int>(std::floor(topLeft.y)), 0, rows - 1) / block;
+        int firstCol = std::clamp(static_cast<int>(std::floor(topLeft.x)), 0, cols - 1) / block;
+        int lastRow = std::clamp(static_cast<int>(std::ceil(bottomRight.y)), 1, rows) - 1;
+        int lastCol = std::clamp(static_cast<int>(std::ceil(bottomRight.x)), 1, cols) - 1;
+        int width = lastCol / block - firstCol + 1;
+        int height = lastRow / block - firstRow + 1;
+        
+        cellPixels.resize(static_cast<size_t>(width) * height * 4);
+        for (int i = 0; i < height; i++) {
+            for (int j = 0; j < width; j++) {
+                float fill = level == 0 ? (grid.getCell(firstRow + i, firstCol + j) ? 1.0f : 0.0f)
+                                        : density.density(level, firstRow + i, firstCol + j);
+                paintTexel(i * width + j, fill);
+            }
+        }
+        sf::Vector2u textureSize = cellTexture.getSize();
+        if ((textureSize.x < static_cast<unsigned>(width) || textureSize.y < static_cast<unsigned>(height)) &&
+            !cellTexture.resize(sf::Vector2u(std::max<unsigned>(textureSize.x, width), std::max<unsigned>(textureSize.y, height)))) {
+            cout << "Could not create a " << width << "x" << height << " texture for the board.\n";
+        }
+        cellTexture.update(cellPixels.data(), sf::Vector2u(width, height), sf::Vector2u(0, 0));
+        cellSprite.setTexture(cellTexture);
+        cellSprite.setTextureRect(sf::IntRect(sf::Vector2i(0, 0), sf::Vector2i(width, height)));
+        cellSprite.setPosition(sf::Vector2f(firstCol * block, firstRow * block));
+        cellSprite.setScale(sf::Vector2f(block, block));
+        viewLevel = level;
+        viewFirst = sf::Vector2i(firstCol, firstRow);
+        viewSize = sf::Vector2i(width, height);
+        
+        gridLines.clear();
+        if (scale >= MIN_LINE_CELL_PIXELS) {
+            sf::Color lineColor(189, 195, 199); // Light gray outline
+            for (int i = firstRow; i <= lastRow + 1; i++) {
+                gridLines.append(sf::Vertex{sf::Vector2f(firstCol, i), lineColor});
+                gridLines.append(sf::Vertex{sf::Vector2f(lastCol + 1, i), lineColor});
+            }
+            for (int j = firstCol; j <= lastCol + 1; j++) {
+                gridLines.append(sf::Vertex{sf::Vector2f(j, firstRow), lineColor});
+                gridLines.append(sf::Vertex{sf::Vector2f(j, lastRow + 1), lineColor});
+            }
+        }
+        viewDirty = false;
+    }
+    
+    // Shapes and text that stay the same from frame to frame
+    void buildLayout() {
+        // Title bar background
+        titleBar.setSize(sf::Vector2f(window.getSize().x, 60));
+        titleBar.setPosition(sf::Vector2f(0, 0));
+        titleBar.setFillColor(sf::Color(52, 73, 94)); // Dark blue-gray
+        
+        // Grid border
+        gridBorder.setSize(sf::Vector2f(gridArea.size.x + GRID_BORDER * 2, gridArea.size.y + GRID_BORDER * 2));
+        gridBorder.setPosition(sf::Vector2f(gridArea.position.x - GRID_BORDER, gridArea.position.y - GRID_BORDER));
+        gridBorder.setFillColor(sf::Color(189, 195, 199)); // Light gray border
+        gridBorder.setOutlineColor(sf::Color(149, 165, 166)); // Darker gray outline
+        gridBorder.setOutlineThickness(2);
+        
+        // Calculate Y position for the instructions panel and text
+        float panelY = window.getSize().y - TEXT_HEIGHT + 10;
+        // Instructions panel background
+        instructionPanel.setSize(sf::Vector2f(window.getSize().x - 20, TEXT_HEIGHT - 20));
+        instructionPanel.setPosition(sf::Vector2f(10, panelY));
+        instructionPanel.setFillColor(sf::Color(255, 255, 255)); // White background
+        instructionPanel.setOutlineColor(sf::Color(189, 195, 199)); // Light gray border
+        instructionPanel.setOutlineThickness(1);
+        
+        if (!fontLoaded) {
+            return;
+        }
+        auto addLabel = [&](const string& text, unsigned size, sf::Color color, float x, float y) {
+            sf::Text label(font, text, size);
+            label.setFillColor(color);
+            label.setPosition(sf::Vector2f(x, y));
+            labels.push_back(label);
+        };
+        addLabel("Manual Setup - Conway's Game of Life", 18, sf::Color::White, 20, 20);
+        addLabel("Click cells to toggle them alive/dead", 14, sf::Color(52, 73, 94), 20, panelY + 10);
+        addLabel("Controls: 'S' save | 'ESC' cancel | Wheel or +/- zoom | Right-drag or arrows pan | Home resets view",
+                 12, sf::Color(149, 165, 166), 20, panelY + 35);
+        addLabel("Live Cells:", 12, sf::Color(149, 165, 166), 20, panelY + 60);
+        addLabel("Grid: " + to_string(grid.getRows()) + "x" + to_string(grid.getCols()),
+                 12, sf::Color(149, 165, 166), 200, panelY + 60);
+        
+        cellCount.emplace(font, to_string(liveCells), 16);
+        cellCount->setFillColor(sf::Color(46, 204, 113)); // Green color
+        cellCount->setPosition(sf::Vector2f(100, panelY + 58));
+    }
+    
+    // Set one texel of the RGBA copy between the dead (fill 0) and live
+    // (fill 1) colours; the caller uploads it
+    void paintTexel(size_t index, float fill) {
+        const sf::Color live(46, 204, 113);    // Green for live cells
+        const sf::Color dead(236, 240, 241);   // Very light gray
+        uint8_t* texel = &cellPixels[index * 4];
+        texel[0] = static_cast<uint8_t>(dead.r + (live.r - dead.r) * fill);
+        texel[1] = static_cast<uint8_t>(dead.g + (live.g - dead.g) * fill);
+        texel[2] = static_cast<uint8_t>(dead.b + (live.b - dead.b) * fill);
+        texel[3] = 255;
+    }
+    
+    // Repaint and upload the one texel showing the block that holds cell
+    // (row, col), if it is in view
+    void repaintBlock(int row, int col) {
+        int x = (col >> viewLevel) - viewFirst.x;
+        int y = (row >> viewLevel) - viewFirst.y;
+        if (x < 0 || y < 0 || x >= viewSize.x || y >= viewSize.y) {
+            return;
+        }
+        float fill = viewLevel == 0 ? (grid.getCell(row, col) ? 1.0f : 0.0f)
+                                    : density.density(viewLevel, row >> viewLevel, col >> viewLevel);
+        size_t index = static_cast<size_t>(y) * viewSize.x + x;
+        paintTexel(index, fill);
+        cellTexture.update(&cellPixels[index * 4], sf::Vector2u(1, 1), sf::Vector2u(x, y));
+    }
+    
     void handleMouseClick(int mouseX, int mouseY) {
+        sf::Vector2i pixel(mouseX, mouseY);
+        if (!gridArea.contains(sf::Vector2f(mouseX, mouseY))) {
+            return;
+        }
+        
         // Calculate grid position from mouse coordinates
-        int gridX = (mouseX - WINDOW_PADDING) / CELL_SIZE;
-        int gridY = (mouseY - WINDOW_PADDING) / CELL_SIZE;
+        sf::Vector2f board = window.mapPixelToCoords(pixel, gridView);
+        int gridX = static_cast<int>(std::floor(board.x));
+        int gridY = static_cast<int>(std::floor(board.y));
         
         // Check if click is within grid bounds
         if (gridX >= 0 && gridX < grid.getCols() && 
             gridY >= 0 && gridY < grid.getRows()) {
-            // Toggle cell state
-            bool currentState = grid.getCell(gridY, gridX);
-            grid.setCell(gridY, gridX, !currentState);
+            // Toggle cell state and the counts of the blocks holding it
+            bool alive = !grid.getCell(gridY, gridX);
+            grid.setCell(gridY, gridX, alive);
+            density.cellChanged(gridY, gridX, alive);
+            if (!viewDirty) {
+                repaintBlock(gridY, gridX);
+            }
+            
+            liveCells += alive ? 1 : -1;
+            if (cellCount) {
+                cellCount->setString(to_string(liveCells));
+            }
+        }
+    }
+    
+    void handleViewKey(sf::Keyboard::Key code) {
+        sf::Vector2f size = gridView.getSize();
+        sf::Vector2i centre(static_cast<int>(gridArea.position.x + gridArea.size.x / 2),
+                            static_cast<int>(gridArea.position.y + gridArea.size.y / 2));
+        switch (code) {
+            case sf::Keyboard::Key::Left: panBy(sf::Vector2f(-size.x * PAN_STEP, 0)); break;
+            case sf::Keyboard::Key::Right: panBy(sf::Vector2f(size.x * PAN_STEP, 0)); break;
+            case sf::Keyboard::Key::Up: panBy(sf::Vector2f(0, -size.y * PAN_STEP)); break;
+            case sf::Keyboard::Key::Down: panBy(sf::Vector2f(0, size.y * PAN_STEP)); break;
+            case sf::Keyboard::Key::Equal:
+            case sf::Keyboard::Key::Add: zoomAt(centre, 1 / ZOOM_STEP); break;
+            case sf::Keyboard::Key::Hyphen:
+            case sf::Keyboard::Key::Subtract: zoomAt(centre, ZOOM_STEP); break;
+            case sf::Keyboard::Key::Home:
+                gridView.setSize(sf::Vector2f(grid.getCols(), grid.getRows()));
+                gridView.setCenter(sf::Vector2f(grid.getCols() / 2.0f, grid.getRows() / 2.0f));
+                viewDirty = true;
+                break;
+            default: break;
+        }
+    }
+    
+    float pixelsPerCell() const {
+        return gridArea.size.x / gridView.getSize().x;
+    }
+    
+    // Move the view by an offset in cells, keeping the board's centre in sight
+    void panBy(sf::Vector2f offset) {
+        sf::Vector2f centre = gridView.getCenter() + offset;
+        centre.x = std::clamp(centre.x, 0.0f, static_cast<float>(grid.getCols()));
+        centre.y = std::clamp(centre.y, 0.0f, static_cast<float>(grid.getRows()));
+        gridView.setCenter(centre);
+        viewDirty = true;
+    }
+    
+    // Zoom by factor (below 1 zooms in) keeping the cell under pixel in place
+    void zoomAt(sf::Vector2i pixel, float factor) {
+        float scale = pixelsPerCell() / factor;
+        if (scale < fitScale / 2 || scale > std::max(fitScale, MAX_CELL_PIXELS)) {
+            return;
         }
+        sf::Vector2f before = window.mapPixelToCoords(pixel, gridView);
+        gridView.zoom(factor);
+        panBy(before - window.mapPixelToCoords(pixel, gridView));
     }
     
     void render() {
         // Modern gradient-like background
         window.clear(sf::Color(245, 247, 250)); // Light blue-gray background
         
-        // Draw title bar background
-        sf::RectangleShape titleBar(sf::Vector2f(window.getSize().x, 60));
-        titleBar.setPosition(sf::Vector2f(0, 0));
-        titleBar.setFillColor(sf::Color(52, 73, 94)); // Dark blue-gray
+        window.setView(window.getDefaultView());
         window.draw(titleBar);
-        
-        // Draw grid border
-        sf::RectangleShape gridBorder(sf::Vector2f(
-            grid.getCols() * CELL_SIZE + GRID_BORDER * 2,
-            grid.getRows() * CELL_SIZE + GRID_BORDER * 2
-        ));
-        gridBorder.setPosition(sf::Vector2f(WINDOW_PADDING - GRID_BORDER, WINDOW_PADDING - GRID_BORDER));
-        gridBorder.setFillColor(sf::Color(189, 195, 199)); // Light gray border
-        gridBorder.setOutlineColor(sf::Color(149, 165, 166)); // Darker gray outline
-        gridBorder.setOutlineThickness(2);
         window.draw(gridBorder);
         
-        // Draw grid cells with improved styling
-        for (int i = 0; i < grid.getRows(); i++) {
-            for (int j = 0; j < grid.getCols(); j++) {
-                sf::RectangleShape cell(sf::Vector2f(CELL_SIZE - 1, CELL_SIZE - 1));
-                cell.setPosition(sf::Vector2f(WINDOW_PADDING + j * CELL_SIZE, WINDOW_PADDING + i * CELL_SIZE));
-                
-                if (grid.getCell(i, j)) {
-                    // Live cell with gradient effect
-                    cell.setFillColor(sf::Color(46, 204, 113)); // Green for live cells
-                    cell.setOutlineColor(sf::Color(39, 174, 96)); // Darker green outline
-                    cell.setOutlineThickness(1);
-                } else {
-                    // Dead cell with subtle styling
-                    cell.setFillColor(sf::Color(236, 240, 241)); // Very light gray
-                    cell.setOutlineColor(sf::Color(189, 195, 199)); // Light gray outline
-                    cell.setOutlineThickness(0.5f);
-                }
-                
-                window.draw(cell);
-            }
+        // The board, with cell borders once they are wide enough to see
+        if (viewDirty) {
+            buildView();
         }
+        window.setView(gridView);
+        window.draw(cellSprite);
+        window.draw(gridLines);
         
-        // Calculate Y position for the instructions panel and text
-        int panelY = window.getSize().y - TEXT_HEIGHT + 10;
-        // Draw instructions panel background
-        sf::RectangleShape instructionPanel(sf::Vector2f(window.getSize().x - 20, TEXT_HEIGHT - 20));
-        instructionPanel.setPosition(sf::Vector2f(10, panelY));
-        instructionPanel.setFillColor(sf::Color(255, 255, 255)); // White background
-        instructionPanel.setOutlineColor(sf::Color(189, 195, 199)); // Light gray border
-        instructionPanel.setOutlineThickness(1);
+        window.setView(window.getDefaultView());
         window.draw(instructionPanel);
-        
-        // Draw text elements
-        if (fontLoaded) {
-            // Title
-            sf::Text title(font, "Manual Setup - Conway's Game of Life");
-            title.setCharacterSize(18);
-            title.setFillColor(sf::Color::White);
-            title.setPosition(sf::Vector2f(20, 20));
-            window.draw(title);
-            
-            // Instructions
-            sf::Text instructions(font, "Click cells to toggle them alive/dead");
-            instructions.setCharacterSize(14);
-            instructions.setFillColor(sf::Color(52, 73, 94)); // Dark blue-gray
-            instructions.setPosition(sf::Vector2f(20, panelY + 10));
-            window.draw(instructions);
-            
-            // Controls
-            sf::Text controls(font, "Controls: Press 'S' to save | Press 'ESC' to cancel");
-            controls.setCharacterSize(12);
-            controls.setFillColor(sf::Color(149, 165, 166)); // Medium gray
-            controls.setPosition(sf::Vector2f(20, panelY + 35));
-            window.draw(controls);
-            
-            // Live cell count with better styling
-            sf::Text cellCountLabel(font, "Live Cells:");
-            cellCountLabel.setCharacterSize(12);
-            cellCountLabel.setFillColor(sf::Color(149, 165, 166)); // Medium gray
-            cellCountLabel.setPosition(sf::Vector2f(20, panelY + 60));
-            window.draw(cellCountLabel);
-            
-            sf::Text cellCount(font, to_string(grid.countLiveCells()));
-            cellCount.setCharacterSize(16);
-            cellCount.setFillColor(sf::Color(46, 204, 113)); // Green color
-            cellCount.setPosition(sf::Vector2f(100, panelY + 58));
-            window.draw(cellCount);
-            
-            // Grid size info
-            sf::Text gridInfo(font, "Grid: " + to_string(grid.getRows()) + "x" + to_string(grid.getCols()));
-            gridInfo.setCharacterSize(12);
-            gridInfo.setFillColor(sf::Color(149, 165, 166)); // Medium gray
-            gridInfo.setPosition(sf::Vector2f(200, panelY + 60));
-            window.draw(gridInfo);
+        for (const sf::Text& label : labels) {
+            window.draw(label);
+        }
+        if (cellCount) {
+            window.draw(*cellCount);
         }
         
         window.display();
@@ -339,31 +604,290 @@ private:
 class GameEngine {
 private:
     Grid currentGrid;
-    Grid nextGrid;
-    Grid previousGrid;
+    Grid nextGrid;          // Scratch output of the SCALAR kernel
+    GenerationRing history; // Recent generations and their hashes
+    int cyclePeriod;        // Period of the cycle the board is in, 0 if none
     int generation;
     int liveCells;
     GameMode mode;
     int targetGenerations;
+    EvolveKernel kernel;
+    ActiveTileTracker tracker;
+    ThreadPool pool;
+    HashLife hashLife;
+    TemporalBlocker blocker;
+    Topology topology;
+    SparseUniverse universe;
+    long long viewTop;   // Plane coordinates of the viewport's top-left cell
+    long long viewLeft;
+    life::Rule rule;
+    life::RuleKernel ruleKernel;  // Packed kernel compiled for rule
+    Timeline timeline;            // Every generation of the torus so far, for stepping back
+    bool recording;
+    unique_ptr<GenerationTrace> trace;  // Phase timings of each generation; null unless tracing
+    life::PatternCensus census;   // Names the objects on the board for Pattern Creation
+    bool gliderOnBoard;           // Only kept up to date in Pattern Creation
+    
+    // Apply the rule one cell at a time
+    void evolveScalar() {
+        for (int i = 0; i < currentGrid.getRows(); i++) {
+            for (int j = 0; j < currentGrid.getCols(); j++) {
+                int neighbors = currentGrid.countLiveNeighbors(i, j);
+                
+                // Live cells survive, and dead cells are born, at the rule's neighbor counts
+                nextGrid.setCell(i, j, life::ruleNextState(rule, currentGrid.getCell(i, j), neighbors));
+            }
+        }
+    }
+    
+    // Look for the glider Pattern Creation asks for; other modes skip the census
+    void updatePatternGoal() {
+        gliderOnBoard = mode == GameMode::PATTERN_CREATION && census.contains(currentGrid.getBits(), "glider");
+    }
+    
+    // The grid was changed from outside evolve(): earlier generations no longer lead to it
+    void resetHistory() {
+        tracker.invalidate();
+        history.reset(life::hashGrid(currentGrid.getBits()));
+        cyclePeriod = 0;
+        updatePatternGoal();
+    }
+    
+    // A new board was written into the grid
+    void boardReplaced() {
+        liveCells = currentGrid.countLiveCells();
+        resetHistory();
+        syncUniverse();
+        restartTimeline();
+    }
+    
+    // Record from the current generation on, forgetting the recorded run. The
+    // plane's viewport is not the whole board, so it is never recorded.
+    void restartTimeline() {
+        if (recording && topology == Topology::TORUS) {
+            timeline.start(currentGrid.getBits(), generation);
+        } else {
+            timeline.clear();
+        }
+    }
+    
+    // Replace the plane's contents with the viewport after the grid was edited directly
+    void syncUniverse() {
+        if (topology == Topology::INFINITE_PLANE) {
+            universe.clear();
+            universe.loadFrom(currentGrid.getBits(), viewTop, viewLeft);
+        }
+    }
+    
+    // Give every per-board buffer new dimensions; the board is left empty
+    void resizeBoard(int rows, int cols) {
+        currentGrid = Grid(rows, cols);
+        nextGrid = Grid(rows, cols);
+        history.resize(history.getDepth(), rows, cols);
+        tracker = ActiveTileTracker(rows, cols);
+        tracker.setRingDepth(history.getDepth());
+        tracker.setRule(rule);
+    }
+    
+    // The torus is written as is; on the plane, the bounding box of every live
+    // cell is written with its position, so nothing outside the viewport is lost
+    bool saveSnapshot(const string& filename) const {
+        life::SnapshotInfo info;
+        info.generation = generation;
+        info.rule = life::ruleString(rule);
+        string error;
+        bool saved;
+        long long top, left, bottom, right;
+        if (topology == Topology::INFINITE_PLANE && universe.getBounds(top, left, bottom, right)) {
+            if (bottom - top >= numeric_limits<int>::max() || right - left >= numeric_limits<int>::max()) {
+                cout << "Snapshot error: the live cells span too large an area\n";
+                return false;
+            }
+            BitGrid box(static_cast<int>(bottom - top + 1), static_cast<int>(right - left + 1));
+            universe.extract(box, top, left);
+            info.originRow = top;
+            info.originCol = left;
+            saved = life::writeSnapshot(filename, box, info, true, error);
+        } else {
+            info.originRow = viewTop;
+            info.originCol = viewLeft;
+            saved = life::writeSnapshot(filename, currentGrid.getBits(), info, true, error);
+        }
+        if (!saved) {
+            cout << "Snapshot error: " << error << "\n";
+        }
+        return saved;
+    }
+    
+    // Resume from a snapshot: a torus takes on the snapshot's dimensions, the
+    // plane receives its cells at the recorded position
+    bool loadSnapshot(const string& filename) {
+        life::MappedSnapshot snapshot;
+        string error;
+        if (!snapshot.open(filename, error)) {
+            cout << "Snapshot error: " << error << "\n";
+            return false;
+        }
+        life::SnapshotInfo info = snapshot.getInfo();
+        
+        // Decoded aside, so a corrupt snapshot leaves the board as it was
+        BitGrid cells(1, 1);
+        if (!snapshot.load(cells, error)) {
+            cout << "Snapshot error: " << error << "\n";
+            return false;
+        }
+        if (topology == Topology::INFINITE_PLANE) {
+            universe.clear();
+            universe.loadFrom(cells, info.originRow, info.originCol);
+            universe.extract(currentGrid.getBits(), viewTop, viewLeft);
+        } else {
+            if (snapshot.getRows() != currentGrid.getRows() || snapshot.getCols() != currentGrid.getCols()) {
+                resizeBoard(snapshot.getRows(), snapshot.getCols());
+            }
+            swap(currentGrid.getBits(), cells);
+        }
+        
+        cout << "Resumed a " << snapshot.getRows() << "x" << snapshot.getCols()
+             << " snapshot at generation " << info.generation << " (rule " << info.rule << ")\n";
+        life::Rule savedRule;
+        if (!life::parseRule(info.rule, savedRule, error) || !setRule(savedRule)) {
+            cout << "Warning: continuing with " << life::ruleString(rule) << " instead of the snapshot's rule.\n";
+        }
+        resetHistory();
+        liveCells = topology == Topology::INFINITE_PLANE ? static_cast<int>(universe.getPopulation())
+                                                         : currentGrid.countLiveCells();
+        generation = info.generation > numeric_limits<int>::max() ? numeric_limits<int>::max() : static_cast<int>(info.generation);
+        restartTimeline();
+        return true;
+    }
+    
+    // Resume a recorded run at its first generation; the rest of the run can
+    // be stepped or sought through
+    bool loadReplay(const string& filename) {
+        if (topology != Topology::TORUS) {
+            cout << "Replay error: replays can only be played on the torus\n";
+            return false;
+        }
+        Timeline replay;
+        string ruleText, error;
+        if (!replay.read(filename, ruleText, error)) {
+            cout << "Replay error: " << error << "\n";
+            return false;
+        }
+        if (replay.getLastGeneration() > numeric_limits<int>::max()) {
+            cout << "Replay error: the run is too long to play\n";
+            return false;
+        }
+        
+        const BitGrid& first = replay.getGrid();
+        if (first.getRows() != currentGrid.getRows() || first.getCols() != currentGrid.getCols()) {
+            resizeBoard(first.getRows(), first.getCols());
+        }
+        currentGrid.getBits() = first;
+        life::Rule savedRule;
+        if (!life::parseRule(ruleText, savedRule, error) || !setRule(savedRule)) {
+            cout << "Warning: continuing with " << life::ruleString(rule) << " instead of the replay's rule.\n";
+        }
+        timeline = std::move(replay);
+        resetHistory();
+        liveCells = currentGrid.countLiveCells();
+        generation = static_cast<int>(timeline.getGeneration());
+        cout << "Loaded a " << first.getRows() << "x" << first.getCols() << " replay of generations "
+             << timeline.getFirstGeneration() << "-" << timeline.getLastGeneration() << " (rule " << ruleText << ")\n";
+        return true;
+    }
     
 public:
     GameEngine(int rows, int cols) 
-        : currentGrid(rows, cols), nextGrid(rows, cols), previousGrid(rows, cols) {
+        : currentGrid(rows, cols), nextGrid(rows, cols), history(GenerationRing::DEFAULT_DEPTH, rows, cols),
+          tracker(rows, cols) {
+        tracker.setRingDepth(history.getDepth());
+        cyclePeriod = 0;
         generation = 0;
         liveCells = 0;
         mode = GameMode::SURVIVAL_GOAL;
         targetGenerations = 50;
+        kernel = EvolveKernel::ACTIVE_TILES;
+        topology = Topology::TORUS;
+        viewTop = 0;
+        viewLeft = 0;
+        rule = life::CONWAY;
+        ruleKernel = life::fastRuleKernel(rule);
+        recording = true;
+        gliderOnBoard = false;
+        restartTimeline();
     }
     
     // Game setup methods
     void setGameMode(GameMode newMode, int target = 50) {
         mode = newMode;
         targetGenerations = target;
+        updatePatternGoal();
+    }
+    
+    // Switch every kernel to a Life-like rule. Fails on the infinite plane for
+    // rules with B0, under which empty space would come alive.
+    bool setRule(const life::Rule& newRule) {
+        if (!universe.setRule(newRule) && topology == Topology::INFINITE_PLANE) {
+            return false;
+        }
+        rule = newRule;
+        ruleKernel = life::fastRuleKernel(rule);
+        tracker.setRule(rule);
+        hashLife.setRule(rule);
+        resetHistory();
+        return true;
+    }
+    
+    const life::Rule& getRule() const { return rule; }
+    
+    void setKernel(EvolveKernel newKernel) {
+        kernel = newKernel;
+        resetHistory();
+    }
+    
+    // Threads used to compute each generation (0 = one per core); the result
+    // is identical for any count
+    void setThreadCount(int threads) {
+        pool.setThreadCount(threads);
+    }
+    
+    int getThreadCount() const { return pool.getThreadCount(); }
+    
+    // On the infinite plane the board is a viewport, initially at the origin,
+    // and patterns that leave it keep evolving outside
+    void setTopology(Topology newTopology) {
+        topology = newTopology;
+        viewTop = 0;
+        viewLeft = 0;
+        syncUniverse();
+        resetHistory();
+        restartTimeline();
+    }
+    
+    Topology getTopology() const { return topology; }
+    
+    // Move the viewport so the live cells are centred in it
+    void centreView() {
+        long long top, left, bottom, right;
+        if (topology != Topology::INFINITE_PLANE || !universe.getBounds(top, left, bottom, right)) {
+            return;
+        }
+        viewTop = (top + bottom) / 2 - currentGrid.getRows() / 2;
+        viewLeft = (left + right) / 2 - currentGrid.getCols() / 2;
+        universe.extract(currentGrid.getBits(), viewTop, viewLeft);
     }
     
     void randomFill(double density = 0.3) {
         currentGrid.randomFill(density);
-        liveCells = currentGrid.countLiveCells();
+        boardReplaced();
+    }
+    
+    // A reproducible soup, starting a new game at generation 0
+    void randomFill(double density, uint64_t seed) {
+        currentGrid.randomFill(density, seed);
+        generation = 0;
+        boardReplaced();
     }
     
     bool manualSetup() {
@@ -375,6 +899,9 @@ public:
         ManualSetupWindow setupWindow(currentGrid);
         bool saved = setupWindow.run();
         
+        resetHistory();
+        syncUniverse();
+        restartTimeline();
         if (saved) {
             liveCells = currentGrid.countLiveCells();
             cout << "Manual setup complete. " << liveCells << " cells set to alive.\n";
@@ -387,77 +914,215 @@ public:
     
     // Evolution methods
     void evolve() {
-        // Store current state for stability check
-        previousGrid.copyFrom(currentGrid);
+        // Tracing costs this one test when it is off
+        life::GenerationSample* sample = trace ? &trace->begin(generation + 1) : nullptr;
+        life::PhaseClock clock;
         
-        // Apply Conway's rules
-        for (int i = 0; i < currentGrid.getRows(); i++) {
-            for (int j = 0; j < currentGrid.getCols(); j++) {
-                int neighbors = currentGrid.countLiveNeighbors(i, j);
-                
-                if (currentGrid.getCell(i, j)) {
-                    // Live cell: survives with 2-3 neighbors
-                    nextGrid.setCell(i, j, (neighbors == 2 || neighbors == 3));
-                } else {
-                    // Dead cell: becomes alive with exactly 3 neighbors
-                    nextGrid.setCell(i, j, (neighbors == 3));
-                }
+        if (topology == Topology::INFINITE_PLANE) {
+            universe.step();
+            universe.extract(currentGrid.getBits(), viewTop, viewLeft);
+            generation++;
+            liveCells = static_cast<int>(universe.getPopulation());
+            cyclePeriod = universe.isStill() ? 1 : 0;
+            updatePatternGoal();
+            if (sample) {
+                sample->phaseNs[static_cast<int>(life::TracePhase::STEP)] = clock.lap();
+                sample->population = liveCells;
+                trace->commit();
             }
+            return;
+        }
+        
+        // The next generation goes straight into the oldest buffer of the ring,
+        // which then swaps places with the current grid
+        BitGrid& next = history.nextSlot();
+        switch (kernel) {
+            case EvolveKernel::SCALAR:
+                evolveScalar();
+                swap(nextGrid.getBits(), next);
+                break;
+            case EvolveKernel::PACKED:
+                life::stepParallel(currentGrid.getBits(), next, pool, ruleKernel);
+                break;
+            case EvolveKernel::ACTIVE_TILES:
+                // The oldest buffer still holds the generation depth - 1 back,
+                // which is what unchanged tiles are skipped against
+                tracker.step(currentGrid.getBits(), next, &pool);
+                break;
         }
+        uint32_t stepNs = sample ? clock.lap() : 0;
+        
+        // The tracker reports the hash change of the tiles it touched; the
+        // other kernels hash the whole grid
+        uint64_t nextHash = kernel == EvolveKernel::ACTIVE_TILES ? history.getCurrentHash() ^ tracker.getHashDelta()
+                                                                 : life::hashGrid(next);
+        uint32_t hashNs = sample ? clock.lap() : 0;
+        history.advance(currentGrid.getBits(), nextHash);
+        uint32_t swapNs = sample ? clock.lap() : 0;
         
-        // Update current grid
-        currentGrid.copyFrom(nextGrid);
         generation++;
         liveCells = currentGrid.countLiveCells();
+        uint32_t statsNs = sample ? clock.lap() : 0;
+        cyclePeriod = history.findPeriod(currentGrid.getBits());
+        updatePatternGoal();
+        uint32_t detectionNs = sample ? clock.lap() : 0;
+        if (recording) {
+            timeline.record(currentGrid.getBits(), generation);
+        }
+        
+        if (sample) {
+            sample->phaseNs[static_cast<int>(life::TracePhase::STEP)] = stepNs;
+            sample->phaseNs[static_cast<int>(life::TracePhase::SWAP)] = swapNs;
+            sample->phaseNs[static_cast<int>(life::TracePhase::STATS)] = statsNs;
+            sample->phaseNs[static_cast<int>(life::TracePhase::DETECTION)] = hashNs + detectionNs;
+            sample->phaseNs[static_cast<int>(life::TracePhase::RECORD)] = clock.lap();
+            sample->population = liveCells;
+            sample->changedCells = life::countChangedCells(history.previous(), currentGrid.getBits());
+            sample->activeTiles = getActiveTiles();
+            trace->commit();
+        }
     }
     
-    // Game state checking
-    bool isGameWon() const {
-        switch (mode) {
-            case GameMode::STABILITY_GOAL:
-                return generation > 0 && currentGrid.isStable(previousGrid);
-            case GameMode::SURVIVAL_GOAL:
-                return generation >= targetGenerations;
-            case GameMode::POPULATION_TARGET:
-                return liveCells >= 20 && liveCells <= 30 && generation >= targetGenerations;
-            default:
-                return false;
+    // Time every generation from now on into a ring of the last capacity
+    // generations (capacity 0 turns tracing off and drops the samples)
+    void setTracing(size_t capacity) {
+        trace.reset(capacity > 0 ? new GenerationTrace(capacity) : nullptr);
+    }
+    
+    const GenerationTrace* getTrace() const { return trace.get(); }
+    
+    // Keep the run for stepping back and replays (on by default); off, evolve()
+    // does no extra work
+    void setTimelineEnabled(bool enabled) {
+        recording = enabled;
+        restartTimeline();
+    }
+    
+    // Go back to the previous recorded generation, touching only the words
+    // that changed. Generations skipped by a jump were never recorded and are
+    // passed over. False at the start of the timeline.
+    bool stepBack() {
+        Timeline::Change change;
+        if (topology != Topology::TORUS || !timeline.stepBack(currentGrid.getBits(), change)) {
+            return false;
         }
+        generation = static_cast<int>(timeline.getGeneration());
+        liveCells += change.population;
+        tracker.invalidate();
+        history.reset(history.getCurrentHash() ^ change.hash);
+        cyclePeriod = 0;
+        updatePatternGoal();
+        return true;
     }
     
-    bool isGameLost() const {
-        switch (mode) {
-            case GameMode::SURVIVAL_GOAL:
-            case GameMode::POPULATION_TARGET:
-            case GameMode::TIME_ATTACK:
-                return liveCells == 0;
-            default:
-                return false;
+    // Go to the last recorded generation at or before target, backwards or
+    // forwards. False if nothing is recorded.
+    bool seekGeneration(int target) {
+        if (topology != Topology::TORUS || timeline.seek(currentGrid.getBits(), target) < 0) {
+            return false;
         }
+        generation = static_cast<int>(timeline.getGeneration());
+        liveCells = currentGrid.countLiveCells();
+        resetHistory();
+        return true;
     }
     
-    bool isGameComplete() const {
-        return generation >= targetGenerations || isGameWon() || isGameLost();
+    int getFirstRecordedGeneration() const { return static_cast<int>(timeline.getFirstGeneration()); }
+    int getLastRecordedGeneration() const { return static_cast<int>(timeline.getLastGeneration()); }
+    
+    // HashLife can jump the board when it is a power-of-two square torus
+    bool canUseHashLife() const {
+        return topology == Topology::TORUS && HashLife::supportsTorus(currentGrid.getRows(), currentGrid.getCols());
     }
     
-    // Get detailed end-game information
-    string getEndGameMessage() const {
-        if (isGameWon()) {
-            switch (mode) {
-                case GameMode::STABILITY_GOAL:
-                    return "🎉 WIN! You achieved a stable configuration after " + to_string(generation) + " generations!";
-                case GameMode::SURVIVAL_GOAL:
-                    return "🎉 WIN! You survived for " + to_string(generation) + " generations (target: " + to_string(targetGenerations) + ")!";
-                case GameMode::POPULATION_TARGET:
-                    return "🎉 WIN! You maintained population in range (20-30) for " + to_string(generation) + " generations!";
-                case GameMode::PATTERN_CREATION:
-                    return "🎉 WIN! You successfully created a pattern that survived for " + to_string(generation) + " generations!";
-                case GameMode::TIME_ATTACK:
-                    return "🎉 WIN! You survived for " + to_string(generation) + " generations in time attack mode!";
-                default:
-                    return "🎉 WIN! Game completed successfully!";
-            }
-        } else if (isGameLost()) {
+    // Jump 2^k generations ahead. Eligible boards use the HashLife engine for all
+    // but the last generation, which goes through evolve() so the stability check
+    // still has the previous grid; other boards step one generation at a time.
+    bool stepPow2(int k) {
+        if (k < 0 || k > 30) {
+            return false;
+        }
+        long long jump = 1LL << k;
+        if (generation + jump > numeric_limits<int>::max()) {
+            return false;
+        }
+        
+        if (canUseHashLife() && jump > 1) {
+            hashLife.loadTorus(currentGrid.getBits());
+            hashLife.stepTorus(static_cast<uint64_t>(jump - 1));
+            hashLife.storeTorus(currentGrid.getBits());
+            resetHistory();
+            generation += static_cast<int>(jump - 1);
+            evolve();
+        } else {
+            stepMany(static_cast<int>(jump));
+        }
+        return true;
+    }
+    
+    // Advance k generations. A torus too large to stay in cache is stepped
+    // temporally blocked, tile by tile, for all but the last generation, which
+    // goes through evolve() so the stability check still has the previous grid.
+    bool stepMany(int k) {
+        if (k < 1 || generation + static_cast<long long>(k) > numeric_limits<int>::max()) {
+            return false;
+        }
+        
+        BitGrid& bits = currentGrid.getBits();
+        if (topology == Topology::TORUS && kernel != EvolveKernel::SCALAR && k > 1 &&
+            bits.wordCount() >= TemporalBlocker::MIN_WORDS) {
+            blocker.advance(bits, nextGrid.getBits(), k - 1, &pool, ruleKernel);
+            resetHistory();
+            generation += k - 1;
+            evolve();
+        } else {
+            for (int i = 0; i < k; i++) {
+                evolve();
+            }
+        }
+        return true;
+    }
+    
+    // Whether the board as it stands wins, or loses, a game of gameMode played
+    // to target generations
+    bool winsMode(GameMode gameMode, int target) const {
+        return winsGameMode(gameMode, target, generation, liveCells, cyclePeriod,
+                            gameMode == mode && gliderOnBoard);
+    }
+    
+    bool losesMode(GameMode gameMode) const {
+        return losesGameMode(gameMode, liveCells);
+    }
+    
+    // Game state checking
+    bool isGameWon() const { return winsMode(mode, targetGenerations); }
+    bool isGameLost() const { return losesMode(mode); }
+    
+    bool isGameComplete() const {
+        return generation >= targetGenerations || isGameWon() || isGameLost();
+    }
+    
+    // Get detailed end-game information
+    string getEndGameMessage() const {
+        if (isGameWon()) {
+            switch (mode) {
+                case GameMode::STABILITY_GOAL:
+                    if (cyclePeriod > 1) {
+                        return "🎉 WIN! Your board settled into a period-" + to_string(cyclePeriod) + " cycle after " + to_string(generation) + " generations!";
+                    }
+                    return "🎉 WIN! You achieved a stable configuration after " + to_string(generation) + " generations!";
+                case GameMode::SURVIVAL_GOAL:
+                    return "🎉 WIN! You survived for " + to_string(generation) + " generations (target: " + to_string(targetGenerations) + ")!";
+                case GameMode::POPULATION_TARGET:
+                    return "🎉 WIN! You maintained population in range (20-30) for " + to_string(generation) + " generations!";
+                case GameMode::PATTERN_CREATION:
+                    return "🎉 WIN! You successfully created a glider after " + to_string(generation) + " generations!";
+                case GameMode::TIME_ATTACK:
+                    return "🎉 WIN! You survived for " + to_string(generation) + " generations in time attack mode!";
+                default:
+                    return "🎉 WIN! Game completed successfully!";
+            }
+        } else if (isGameLost()) {
             switch (mode) {
                 case GameMode::SURVIVAL_GOAL:
                     return "💀 LOSE! All cells died after " + to_string(generation) + " generations (target: " + to_string(targetGenerations) + ").";
@@ -486,7 +1151,11 @@ public:
     
     // Get current game mode name
     string getGameModeName() const {
-        switch (mode) {
+        return getGameModeName(mode);
+    }
+    
+    static string getGameModeName(GameMode gameMode) {
+        switch (gameMode) {
             case GameMode::STABILITY_GOAL: return "Stability Goal";
             case GameMode::SURVIVAL_GOAL: return "Survival Goal";
             case GameMode::PATTERN_CREATION: return "Pattern Creation";
@@ -499,47 +1168,204 @@ public:
     // Getters
     int getGeneration() const { return generation; }
     int getLiveCells() const { return liveCells; }
+    int getCyclePeriod() const { return cyclePeriod; }
+    int getTileCount() const { return tracker.getTileCount(); }
+    
+    // Tiles recomputed in the last generation (all of them without change tracking)
+    int getActiveTiles() const {
+        return kernel == EvolveKernel::ACTIVE_TILES ? tracker.getActiveTiles() : tracker.getTileCount();
+    }
     const Grid& getCurrentGrid() const { return currentGrid; }
     
+    // One-line summary of what the engine is doing, for the display header
+    string getEngineStatus() const {
+        if (topology == Topology::INFINITE_PLANE) {
+            return "Chunks: " + to_string(universe.getChunkCount()) +
+                   " | View: (" + to_string(viewTop) + ", " + to_string(viewLeft) + ")";
+        }
+        string status = "Active Tiles: " + to_string(getActiveTiles()) + "/" + to_string(getTileCount());
+        if (cyclePeriod > 0) {
+            status += " | Period: " + to_string(cyclePeriod);
+        }
+        return status;
+    }
+    
     // File operations
+    // .snap files are binary snapshots, .replay files the recorded run,
+    // .rle/.lif/.life/.06 files are written as patterns; anything else uses
+    // the grid text format
     bool saveGame(const string& filename) const {
-        return currentGrid.saveToFile(filename);
+        if (life::isSnapshotFile(filename)) {
+            return saveSnapshot(filename);
+        }
+        if (life::isReplayFile(filename)) {
+            string error;
+            if (!timeline.write(filename, life::ruleString(rule), error)) {
+                cout << "Replay error: " << error << "\n";
+                return false;
+            }
+            return true;
+        }
+        if (!life::isPatternFile(filename)) {
+            return currentGrid.saveToFile(filename);
+        }
+        
+        ofstream file(filename, ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        bool rle = life::patternFormatFor(filename) == life::PatternFormat::RLE;
+        
+        if (topology != Topology::INFINITE_PLANE) {
+            if (rle) {
+                life::writeRle(file, currentGrid.getBits(), life::ruleString(rule));
+            } else {
+                life::writeLife106(file, currentGrid.getBits());
+            }
+            return file.good();
+        }
+        
+        // The whole plane, not just the viewport, relative to its bounding box
+        long long top = 0, left = 0, bottom = -1, right = -1;
+        universe.getBounds(top, left, bottom, right);
+        if (rle) {
+            file << "#CXRLE Pos=" << left << "," << top << "\n";
+            life::RleWriter writer(file, right - left + 1, bottom - top + 1, life::ruleString(rule));
+            universe.forEachRun([&](long long row, long long col, long long length) {
+                writer.addRun(row - top, col - left, length);
+            });
+            writer.finish();
+        } else {
+            life::Life106Writer writer(file);
+            universe.forEachRun([&](long long row, long long col, long long length) {
+                writer.addRun(row, col, length);
+            });
+            writer.finish();
+        }
+        return file.good();
     }
     
-    bool loadGame(const string& filename) {
-        if (currentGrid.loadFromFile(filename)) {
-            liveCells = currentGrid.countLiveCells();
-            generation = 0;
-            return true;
+    // Pattern files are streamed in with their top-left cell at (top, left),
+    // wrapping around the torus or extending the plane; grid files must match
+    // the board's dimensions
+    bool loadGame(const string& filename, long long top = 0, long long left = 0) {
+        if (life::isSnapshotFile(filename)) {
+            return loadSnapshot(filename);
         }
-        return false;
+        if (life::isReplayFile(filename)) {
+            return loadReplay(filename);
+        }
+        if (!life::isPatternFile(filename)) {
+            if (!currentGrid.loadFromFile(filename)) {
+                return false;
+            }
+        } else {
+            ifstream file(filename, ios::binary);
+            if (!file.is_open()) {
+                return false;
+            }
+            
+            // Read onto a scratch board, so a malformed file leaves the game as it was
+            life::PatternInfo info;
+            string error;
+            bool loaded;
+            SparseUniverse plane;
+            BitGrid cells(1, 1);
+            if (topology == Topology::INFINITE_PLANE) {
+                plane.setRule(rule);
+                loaded = life::readPattern(file, life::patternFormatFor(filename),
+                    [&](long long row, long long col, long long length) {
+                        for (long long i = 0; i < length; i++) {
+                            plane.set(top + row, left + col + i, true);
+                        }
+                    }, info, error);
+            } else {
+                cells = BitGrid(currentGrid.getRows(), currentGrid.getCols());
+                loaded = life::readPattern(file, life::patternFormatFor(filename),
+                    [&](long long row, long long col, long long length) {
+                        life::placeRun(cells, top + row, left + col, length);
+                    }, info, error);
+            }
+            if (!loaded) {
+                cout << "Pattern error: " << error << "\n";
+                return false;
+            }
+            if (topology == Topology::INFINITE_PLANE) {
+                swap(universe, plane);
+                universe.extract(currentGrid.getBits(), viewTop, viewLeft);
+            } else {
+                swap(currentGrid.getBits(), cells);
+            }
+            
+            cout << "Read " << info.liveCells << " cells (" << info.width << "x" << info.height
+                 << ", rule " << info.rule << ")\n";
+            life::Rule patternRule;
+            if (!life::parseRule(info.rule, patternRule, error) || patternRule != rule) {
+                cout << "Warning: the pattern was made for another rule and will be run as "
+                     << life::ruleString(rule) << ".\n";
+            }
+        }
+        
+        resetHistory();
+        // A pattern loaded onto the plane is already there in full, beyond the viewport too
+        if (!life::isPatternFile(filename)) {
+            syncUniverse();
+        }
+        liveCells = topology == Topology::INFINITE_PLANE ? static_cast<int>(universe.getPopulation())
+                                                         : currentGrid.countLiveCells();
+        generation = 0;
+        restartTimeline();
+        return true;
     }
 };
 
 // Display class to handle visualization
 class GameDisplay {
 public:
-    static void displayGrid(const Grid& grid, int generation, int liveCells) {
-        system("cls"); // Clear screen (Windows)
-        
-        cout << "=== Conway's Game of Life ===\n";
-        cout << "Generation: " << generation << " | Live Cells: " << liveCells << "\n\n";
-        
-        // Print column numbers
-        cout << "   ";
-        for (int j = 0; j < grid.getCols(); j++) {
-            cout << (j % 10) << " ";
+    // Shared by every frame so each one only redraws what changed
+    static TerminalRenderer& terminal() {
+        static TerminalRenderer renderer;
+        return renderer;
+    }
+
+    // Auto-run frames are incremental; any other frame follows prompts that
+    // may have scrolled the screen, so it is redrawn in full
+    static void displayGrid(const Grid& grid, int generation, int liveCells, const string& status = "",
+                            bool incremental = false) {
+        TerminalRenderer& screen = terminal();
+        if (!incremental) {
+            screen.invalidate();
         }
-        cout << "\n";
-        
-        for (int i = 0; i < grid.getRows(); i++) {
-            cout << (i < 10 ? " " : "") << i << " ";
-            for (int j = 0; j < grid.getCols(); j++) {
-                cout << (grid.getCell(i, j) ? "O " : ". ");
+        screen.beginFrame();
+
+        Viewport view = screen.fit(grid.getRows(), grid.getCols(), 2, 3, 4, 1);
+        string header = "Generation: " + to_string(generation) + " | Live Cells: " + to_string(liveCells);
+        if (!status.empty()) {
+            header += " | " + status;
+        }
+        if (view.clipped) {
+            header += " | " + view.label();
+        }
+        screen.line("=== Conway's Game of Life ===");
+        screen.line(header);
+        screen.line("");
+
+        // Column numbers
+        string line = "   ";
+        for (int j = view.firstCol; j < view.firstCol + view.cols; j++) {
+            line += to_string(j % 10) + " ";
+        }
+        screen.line(line);
+
+        for (int i = view.firstRow; i < view.firstRow + view.rows; i++) {
+            line = (i < 10 ? " " : "") + to_string(i) + " ";
+            for (int j = view.firstCol; j < view.firstCol + view.cols; j++) {
+                line += grid.getCell(i, j) ? "O " : ". ";
             }
-            cout << "\n";
+            screen.line(line);
         }
-        cout << "\n";
+        screen.line("");
+        screen.present();
     }
     
     static void showMenu() {
@@ -564,16 +1390,64 @@ public:
     }
 };
 
+// One generation as handed from the simulation thread to the display
+struct SimulationFrame {
+    Grid grid = Grid(0, 0);
+    int generation = 0;
+    int liveCells = 0;
+    string status;
+    bool finished = false;  // The game is over and endMessage says how
+    string endMessage;
+};
+
 // Main game controller class
 class GameController {
 private:
     GameEngine engine;
+    string tracePath;  // Where the generation trace is written on exit; empty if not tracing
+    
+    // Write the trace to tracePath and summarise where the time went
+    void exportTrace() const {
+        const GenerationTrace* trace = engine.getTrace();
+        if (!trace || trace->size() == 0) {
+            return;
+        }
+        string error;
+        if (!trace->writeFile(tracePath, error)) {
+            cout << "Trace error: " << error << "\n";
+            return;
+        }
+        cout << "Traced " << trace->size() << " generations to " << tracePath << " (";
+        for (int p = 0; p < life::TRACE_PHASE_COUNT; p++) {
+            life::TracePhase phase = static_cast<life::TracePhase>(p);
+            cout << (p > 0 ? ", " : "") << life::tracePhaseName(phase) << " "
+                 << fixed << setprecision(2) << trace->totalNs(phase) / 1e6 << " ms";
+        }
+        cout << ")\n";
+    }
     
 public:
-    GameController(int rows, int cols) : engine(rows, cols) {}
+    GameController(int rows, int cols, int threads = 0, Topology topology = Topology::TORUS,
+                   const life::Rule& rule = life::CONWAY) : engine(rows, cols) {
+        engine.setThreadCount(threads);
+        engine.setTopology(topology);
+        engine.setRule(rule);
+    }
+    
+    // Time every generation of the session and write the samples to path
+    // (CSV for a .csv name, else Chrome trace JSON) when it ends
+    void enableTrace(const string& path) {
+        tracePath = path;
+        engine.setTracing(GenerationTrace::DEFAULT_CAPACITY);
+    }
     
     void run() {
-        cout << "=== Conway's Game of Life (OOP Console Version with GUI Manual Setup) ===\n\n";
+        cout << "=== Conway's Game of Life (OOP Console Version with GUI Manual Setup) ===\n";
+        cout << "Generation kernel: " << life::simdLevelName(life::activeSimdLevel())
+             << " | Threads: " << engine.getThreadCount()
+             << " | Universe: " << (engine.getTopology() == Topology::INFINITE_PLANE ? "Infinite plane" : "Torus")
+             << " | Rule: " << life::ruleName(engine.getRule())
+             << "\n\n";
         
         char choice;
         do {
@@ -607,7 +1481,12 @@ public:
                         string filename;
                         cout << "Enter filename to load: ";
                         cin >> filename;
-                        if (engine.loadGame(filename)) {
+                        long long top = 0, left = 0;
+                        if (life::isPatternFile(filename)) {
+                            cout << "Place the pattern's top-left cell at (row col): ";
+                            cin >> top >> left;
+                        }
+                        if (engine.loadGame(filename, top, left)) {
                             cout << "Game loaded successfully!\n";
                         } else {
                             cout << "Failed to load game.\n";
@@ -626,6 +1505,10 @@ public:
             }
             
         } while (choice != '6');
+        
+        if (!tracePath.empty()) {
+            exportTrace();
+        }
     }
     
 private:
@@ -650,12 +1533,12 @@ private:
                 break;
             case 3:
                 mode = GameMode::PATTERN_CREATION;
-                targetGenerations = 50;
+                targetGenerations = PATTERN_CREATION_GENERATIONS;
                 cout << "Pattern creation mode - create a glider pattern!\n";
                 break;
             case 4:
                 mode = GameMode::POPULATION_TARGET;
-                targetGenerations = 100;
+                targetGenerations = POPULATION_TARGET_GENERATIONS;
                 cout << "Population target mode - maintain population in range!\n";
                 break;
             case 5:
@@ -674,13 +1557,27 @@ private:
         cout << "\n=== Starting " << engine.getGameModeName() << " Mode ===\n";
         cout << "Target: " << targetGenerations << " generations\n";
         cout << "Starting simulation...\n";
-        cout << "Press Enter to step through, or 'a' for auto-run: ";
+        cout << "Press Enter to step through, 'a' for auto-run, or 'f' for full-speed auto-run: ";
         char stepChoice;
         cin >> stepChoice;
-        bool autoRun = (stepChoice == 'a' || stepChoice == 'A');
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        if (stepChoice == 'a' || stepChoice == 'A') {
+            runAutomatic(chrono::milliseconds(DISPLAY_DELAY_MS));
+        } else if (stepChoice == 'f' || stepChoice == 'F') {
+            runAutomatic(chrono::milliseconds(0));
+        } else {
+            runStepped(targetGenerations);
+        }
         
+        cout << "\nPress Enter to continue...";
+        cin.get();
+    }
+    
+    // Step one generation per key press, drawing each on this thread
+    void runStepped(int targetGenerations) {
         while (!engine.isGameComplete()) {
-            GameDisplay::displayGrid(engine.getCurrentGrid(), engine.getGeneration(), engine.getLiveCells());
+            GameDisplay::displayGrid(engine.getCurrentGrid(), engine.getGeneration(), engine.getLiveCells(),
+                                     engine.getEngineStatus());
             
             if (engine.isGameWon()) {
                 cout << "\n" << engine.getEndGameMessage() << "\n";
@@ -692,15 +1589,48 @@ private:
                 break;
             }
             
-            engine.evolve();
-            
-            if (!autoRun) {
-                cout << "Press Enter for next generation, 'q' to quit: ";
+            bool onPlane = engine.getTopology() == Topology::INFINITE_PLANE;
+            cout << "Press Enter for next generation, 'j' to jump 2^k generations, 'm' to advance k generations, "
+                 << (onPlane ? "'c' to centre the view, " : "'b' to step back, 's' to seek to a generation, ")
+                 << "'q' to quit: ";
+            string line;
+            if (!getline(cin, line)) break;
+            char input = line.empty() ? '\n' : line[0];
+            if (input == 'q' || input == 'Q') break;
+            if (onPlane && (input == 'c' || input == 'C')) {
+                engine.centreView();
+            } else if (!onPlane && (input == 'b' || input == 'B')) {
+                if (!engine.stepBack()) {
+                    cout << "Already at the first recorded generation.\n";
+                }
+            } else if (!onPlane && (input == 's' || input == 'S')) {
+                int target;
+                cout << "Seek to generation (" << engine.getFirstRecordedGeneration() << "-"
+                     << engine.getLastRecordedGeneration() << "): ";
+                if (cin >> target) {
+                    engine.seekGeneration(target);
+                }
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            } else if (input == 'j' || input == 'J') {
+                int k;
+                cout << "Jump 2^k generations"
+                     << (engine.canUseHashLife() ? " (HashLife)" : "") << ", enter k (0-30): ";
+                cin >> k;
+                if (!engine.stepPow2(k)) {
+                    cout << "Invalid jump size.\n";
+                }
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            } else if (input == 'm' || input == 'M') {
+                int k;
+                cout << "Advance how many generations? ";
+                cin >> k;
+                if (!engine.stepMany(k)) {
+                    cout << "Invalid generation count.\n";
+                }
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                char input = cin.get();
-                if (input == 'q' || input == 'Q') break;
             } else {
-                this_thread::sleep_for(chrono::milliseconds(DISPLAY_DELAY_MS));
+                engine.evolve();
             }
         }
         
@@ -708,26 +1638,1217 @@ private:
         if (!engine.isGameWon() && !engine.isGameLost() && engine.getGeneration() >= targetGenerations) {
             cout << "\n" << engine.getEndGameMessage() << "\n";
         }
+    }
+    
+    // Auto-run: the engine steps on its own thread and publishes generations
+    // into a lock-free frame ring, while this thread redraws the newest one
+    // every RENDER_INTERVAL_MS. A slow generation never freezes the display and
+    // a slow display never holds up the simulation; frames the display has no
+    // time for are dropped. generationInterval paces the simulation, 0 = flat out.
+    void runAutomatic(chrono::milliseconds generationInterval) {
+        SpscRing<SimulationFrame> frames(FRAME_RING_SIZE);
         
-        cout << "\nPress Enter to continue...";
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-        cin.get();
+        thread simulation([&] {
+            chrono::steady_clock::time_point due = chrono::steady_clock::now();
+            while (true) {
+                // The last frame must reach the display, so only it waits for room
+                bool finished = engine.isGameComplete();
+                SimulationFrame* frame = frames.claim();
+                while (finished && !frame) {
+                    this_thread::yield();
+                    frame = frames.claim();
+                }
+                if (frame) {
+                    frame->grid = engine.getCurrentGrid();
+                    frame->generation = engine.getGeneration();
+                    frame->liveCells = engine.getLiveCells();
+                    frame->status = engine.getEngineStatus();
+                    frame->finished = finished;
+                    frame->endMessage = finished ? engine.getEndGameMessage() : "";
+                    frames.publish();
+                }
+                if (finished) {
+                    break;
+                }
+                if (generationInterval.count() > 0) {
+                    due += generationInterval;
+                    this_thread::sleep_until(due);
+                }
+                engine.evolve();
+            }
+        });
+        
+        // The simulation thread owns the engine until it is joined
+        chrono::steady_clock::time_point lastShown = chrono::steady_clock::now();
+        int lastGeneration = -1;
+        while (true) {
+            SimulationFrame* frame = frames.latest();
+            if (frame) {
+                chrono::steady_clock::time_point now = chrono::steady_clock::now();
+                double seconds = chrono::duration<double>(now - lastShown).count();
+                string status = frame->status;
+                bool incremental = lastGeneration >= 0;  // The first frame follows the menu
+                if (incremental && seconds > 0) {
+                    status += (status.empty() ? "" : " | ") +
+                              to_string(llround((frame->generation - lastGeneration) / seconds)) + " gen/s";
+                }
+                lastShown = now;
+                lastGeneration = frame->generation;
+                
+                GameDisplay::displayGrid(frame->grid, frame->generation, frame->liveCells, status, incremental);
+                bool finished = frame->finished;
+                if (finished) {
+                    cout << "\n" << frame->endMessage << "\n";
+                }
+                frames.release();
+                if (finished) {
+                    break;
+                }
+            }
+            this_thread::sleep_for(chrono::milliseconds(RENDER_INTERVAL_MS));
+        }
+        simulation.join();
+    }
+};
+
+// A puzzle game reduced to what deciding its modes needs: a torus board of
+// any type with the board interface of fixed_grid.hpp (Grid or FixedGrid),
+// its generation, population and cycle period. The cycle is found exactly as
+// GameEngine finds it, through a ring of the last generations, so both agree
+// on every outcome; with a FixedGrid the ring and both buffers are inline.
+//
+// Cycles longer than the ring, such as a glider circling the torus, are
+// found separately: every generation's hash is kept with the generation it
+// was first seen at, so a cycle is caught on its first repeat wherever it
+// starts before the run is cut off. A repeated hash is confirmed by
+// replaying the soup to the earlier generation, which happens once a soup.
+template <typename Board>
+class PuzzleRun {
+private:
+    Board current;
+    BasicGenerationRing<Board> history;
+    typename Board::Kernel kernel;
+    int generation;
+    int liveCells;
+    int cyclePeriod;
+    
+    Board start;                // Generation 0, replayed to confirm a repeated hash
+    unordered_map<uint64_t, int> seen;  // Generation each board hash was first seen at
+    int longPeriod;             // Period of a cycle too long for the ring, 0 if none found yet
+    int longStart;              // First generation of that cycle
+    
+    void restartCycleSearch() {
+        start = current;
+        seen.clear();
+        seen.emplace(history.getCurrentHash(), generation);
+        longPeriod = 0;
+        longStart = 0;
+    }
+    
+    // The board as it was at an earlier generation
+    Board replayTo(int target) const {
+        Board board = start;
+        Board scratch = start;
+        for (int i = 0; i < target; i++) {
+            board.stepInto(scratch, kernel);
+            swap(board, scratch);
+        }
+        return board;
+    }
+    
+public:
+    PuzzleRun(int rows, int cols, const life::Rule& rule)
+        : current(rows, cols), history(GenerationRing::DEFAULT_DEPTH, rows, cols), kernel(Board::kernelFor(rule)),
+          generation(0), liveCells(0), cyclePeriod(0), start(rows, cols), longPeriod(0), longStart(0) {}
+    
+    // A reproducible soup, starting over at generation 0
+    void randomFill(double density, uint64_t seed) {
+        current.randomFill(density, seed);
+        generation = 0;
+        liveCells = current.countLiveCells();
+        cyclePeriod = 0;
+        history.reset(current.hash());
+        restartCycleSearch();
+    }
+    
+    void evolve() {
+        Board& next = history.nextSlot();
+        current.stepInto(next, kernel);
+        history.advance(current, next.hash());
+        generation++;
+        liveCells = current.countLiveCells();
+        cyclePeriod = history.findPeriod(current);
+        
+        // The first repeat of any generation gives the cycle, however late
+        // it starts; a hash match is only trusted once replayed
+        if (cyclePeriod == 0 && longPeriod == 0) {
+            auto found = seen.emplace(history.getCurrentHash(), generation);
+            if (!found.second && replayTo(found.first->second) == current) {
+                longStart = found.first->second;
+                longPeriod = generation - longStart;
+            }
+        }
+    }
+    
+    // Period of the cycle the board is in, however long, 0 if none found yet
+    int getSettledPeriod() const { return cyclePeriod > 0 ? cyclePeriod : longPeriod; }
+    
+    // First generation of the cycle; only valid once getSettledPeriod() is set
+    int getCycleStart() const {
+        // Either way the cycle is reported on its first repeat
+        return cyclePeriod > 0 ? generation - cyclePeriod : longStart;
+    }
+    
+    // Pattern Creation would need a census every generation, so it is never
+    // won here and the search does not report it
+    bool winsMode(GameMode mode, int target) const {
+        return winsGameMode(mode, target, generation, liveCells, cyclePeriod, false);
     }
+    
+    bool losesMode(GameMode mode) const { return losesGameMode(mode, liveCells); }
+    
+    int getGeneration() const { return generation; }
+    int getLiveCells() const { return liveCells; }
+    int getCyclePeriod() const { return cyclePeriod; }
+    const Board& getBoard() const { return current; }
 };
 
+// Settings of a headless random-soup search (--search)
+struct SearchSettings {
+    long long soups = 100000;
+    int rows = 16;
+    int cols = 16;
+    double density = 0.3;
+    uint64_t seed = 1;                     // Soup i is filled from seed + i
+    int target = 50;                       // Target of the Stability and Survival goals
+    int maxGenerations = MAX_GENERATIONS;  // Soups still changing after this many are unsettled
+    int top = 5;                           // Configurations kept for each ranked mode
+    int threads = 0;
+    life::Rule rule = life::CONWAY;
+};
+
+// Monte Carlo search over random soups for tuning the game modes
+//
+// Every soup is filled from its own seed and run on its worker's PuzzleRun
+// until it dies or repeats, and each game mode is scored on it exactly as a
+// game played through the menus would be, except Pattern Creation: looking
+// for gliders takes an object census of every generation, which would cost
+// about ten times the soup itself, so that row of the report reads n/a
+// (PatternSolver is the tool for it). Common puzzle sizes get a FixedGrid
+// compiled for them, the rest the dynamic Grid. Workers share nothing but
+// the soup counter; their tallies and top-N lists are merged at the end,
+// with ties broken by seed, so the report is the same for any thread count.
+class SoupSearch {
+public:
+    enum class Outcome { WIN, LOSE, TIME_UP, UNDECIDED };
+    static const int OUTCOME_COUNT = 4;
+    
+    // A soup worth keeping; its seed regenerates the initial configuration
+    struct Ranked {
+        uint64_t seed;
+        long long score;
+        int lifespan;
+        int finalPopulation;
+    };
+    
+private:
+    static const int BATCH_SOUPS = 256;   // Soups per task handed to a worker
+    static const int ROUND_BATCHES = 64;  // Tasks per worker between progress reports
+    
+    struct SoupResult {
+        int lifespan;         // Generations before it died or entered its cycle
+        bool settled;         // Died or cycling by maxGenerations
+        bool died;
+        int finalPopulation;
+        int inRangeStreak;    // Generations in the Population Target range up to that mode's target
+        Outcome outcomes[GAME_MODE_COUNT];
+    };
+    
+    // What one worker has seen
+    struct Tally {
+        long long soups = 0;
+        long long died = 0;
+        long long settled = 0;
+        long long lifespanSum = 0;
+        long long populationSum = 0;
+        long long outcomes[GAME_MODE_COUNT][OUTCOME_COUNT] = {};
+        vector<Ranked> bestSurvival;    // Survival Goal wins by lifespan
+        vector<Ranked> bestPopulation;  // Population Target wins by generations in range
+    };
+    
+    SearchSettings settings;
+    
+    int targetFor(GameMode mode) const {
+        switch (mode) {
+            case GameMode::PATTERN_CREATION: return PATTERN_CREATION_GENERATIONS;
+            case GameMode::POPULATION_TARGET: return POPULATION_TARGET_GENERATIONS;
+            case GameMode::TIME_ATTACK: return MAX_GENERATIONS;
+            default: return settings.target;
+        }
+    }
+    
+    // Keep best sorted by score, then seed, and at most settings.top long
+    void offer(vector<Ranked>& best, const Ranked& entry) const {
+        auto better = [](const Ranked& a, const Ranked& b) {
+            return a.score != b.score ? a.score > b.score : a.seed < b.seed;
+        };
+        if (settings.top == 0 || (static_cast<int>(best.size()) == settings.top && !better(entry, best.back()))) {
+            return;
+        }
+        best.insert(upper_bound(best.begin(), best.end(), entry, better), entry);
+        if (static_cast<int>(best.size()) > settings.top) {
+            best.pop_back();
+        }
+    }
+    
+    template <typename Board>
+    void runSoup(PuzzleRun<Board>& game, uint64_t seed, SoupResult& result) const {
+        game.randomFill(settings.density, seed);
+        const int lastTarget = max({settings.target, PATTERN_CREATION_GENERATIONS, POPULATION_TARGET_GENERATIONS});
+        
+        int undecided = GAME_MODE_COUNT;
+        fill(begin(result.outcomes), end(result.outcomes), Outcome::UNDECIDED);
+        result.settled = false;
+        result.died = false;
+        result.inRangeStreak = 0;
+        int streak = 0;
+        while (true) {
+            int generation = game.getGeneration();
+            int live = game.getLiveCells();
+            streak = live >= POPULATION_TARGET_MIN && live <= POPULATION_TARGET_MAX ? streak + 1 : 0;
+            if (generation == POPULATION_TARGET_GENERATIONS) {
+                result.inRangeStreak = streak;
+            }
+            
+            // The order of the game's own end-of-game checks
+            for (int m = 0; m < GAME_MODE_COUNT; m++) {
+                GameMode mode = static_cast<GameMode>(m);
+                if (result.outcomes[m] != Outcome::UNDECIDED) continue;
+                if (game.winsMode(mode, targetFor(mode))) {
+                    result.outcomes[m] = Outcome::WIN;
+                } else if (game.losesMode(mode)) {
+                    result.outcomes[m] = Outcome::LOSE;
+                } else if (generation >= targetFor(mode)) {
+                    result.outcomes[m] = Outcome::TIME_UP;
+                } else {
+                    continue;
+                }
+                undecided--;
+            }
+            
+            if (!result.settled && (live == 0 || game.getSettledPeriod() > 0)) {
+                result.settled = true;
+                result.died = live == 0;
+                result.lifespan = live == 0 ? generation : game.getCycleStart();
+            }
+            // A cycle never dies out, which is all that is left for Time Attack
+            if ((result.settled && (undecided == 0 || generation >= lastTarget)) || generation >= settings.maxGenerations) {
+                break;
+            }
+            game.evolve();
+        }
+        
+        Outcome& timeAttack = result.outcomes[static_cast<int>(GameMode::TIME_ATTACK)];
+        if (result.settled && !result.died && timeAttack == Outcome::UNDECIDED) {
+            timeAttack = Outcome::TIME_UP;
+        }
+        if (!result.settled) {
+            result.lifespan = game.getGeneration();
+        }
+        result.finalPopulation = game.getLiveCells();
+    }
+    
+    void record(Tally& tally, uint64_t seed, const SoupResult& result) const {
+        tally.soups++;
+        tally.died += result.died;
+        tally.settled += result.settled;
+        tally.lifespanSum += result.lifespan;
+        tally.populationSum += result.finalPopulation;
+        for (int m = 0; m < GAME_MODE_COUNT; m++) {
+            tally.outcomes[m][static_cast<int>(result.outcomes[m])]++;
+        }
+        if (result.outcomes[static_cast<int>(GameMode::SURVIVAL_GOAL)] == Outcome::WIN) {
+            offer(tally.bestSurvival, {seed, result.lifespan, result.lifespan, result.finalPopulation});
+        }
+        if (result.outcomes[static_cast<int>(GameMode::POPULATION_TARGET)] == Outcome::WIN) {
+            offer(tally.bestPopulation, {seed, result.inRangeStreak, result.lifespan, result.finalPopulation});
+        }
+    }
+    
+    void merge(Tally& total, const Tally& part) const {
+        total.soups += part.soups;
+        total.died += part.died;
+        total.settled += part.settled;
+        total.lifespanSum += part.lifespanSum;
+        total.populationSum += part.populationSum;
+        for (int m = 0; m < GAME_MODE_COUNT; m++) {
+            for (int o = 0; o < OUTCOME_COUNT; o++) {
+                total.outcomes[m][o] += part.outcomes[m][o];
+            }
+        }
+        for (const Ranked& entry : part.bestSurvival) offer(total.bestSurvival, entry);
+        for (const Ranked& entry : part.bestPopulation) offer(total.bestPopulation, entry);
+    }
+    
+    static string percent(long long count, long long total) {
+        ostringstream text;
+        text << fixed << setprecision(1) << (total > 0 ? 100.0 * count / total : 0.0) << "%";
+        return text.str();
+    }
+    
+    // scoreName is empty when the score is the lifespan
+    void showRanked(const string& title, const string& scoreName, const vector<Ranked>& best) const {
+        cout << "\nTop " << best.size() << " for " << title << ":\n";
+        if (best.empty()) {
+            cout << "  (no soup won this mode)\n";
+        }
+        for (size_t i = 0; i < best.size(); i++) {
+            cout << "#" << i + 1 << " seed " << best[i].seed << ": ";
+            if (!scoreName.empty()) {
+                cout << scoreName << " " << best[i].score << ", ";
+            }
+            cout << "lifespan " << best[i].lifespan << ", final population " << best[i].finalPopulation << "\n";
+            Grid soup(settings.rows, settings.cols);
+            soup.randomFill(settings.density, best[i].seed);
+            life::writeRle(cout, soup.getBits(), life::ruleString(settings.rule));
+        }
+    }
+    
+    void report(const Tally& total, int threads, double seconds) const {
+        cout << "\n=== Random Soup Search ===\n";
+        cout << "Soups: " << total.soups << " on a " << settings.rows << "x" << settings.cols << " torus, density "
+             << settings.density << ", seeds " << settings.seed << "-" << settings.seed + total.soups - 1
+             << ", rule " << life::ruleString(settings.rule) << "\n";
+        cout << "Threads: " << threads << " | Time: " << fixed << setprecision(2) << seconds << " s | "
+             << llround(seconds > 0 ? total.soups / seconds : 0) << " soups/s\n";
+        cout.unsetf(ios::floatfield);
+        cout << "Died out: " << percent(total.died, total.soups)
+             << " | Settled into a still life or cycle: " << percent(total.settled - total.died, total.soups)
+             << " | Still changing after " << settings.maxGenerations << " generations: "
+             << percent(total.soups - total.settled, total.soups) << "\n";
+        if (total.soups > 0) {
+            cout << "Mean lifespan: " << total.lifespanSum / total.soups << " generations | Mean final population: "
+                 << total.populationSum / total.soups << "\n";
+        }
+        
+        cout << "\n" << left << setw(20) << "Game mode" << right << setw(8) << "Target" << setw(9) << "Win"
+             << setw(9) << "Lose" << setw(9) << "Time up" << setw(11) << "Undecided" << "\n";
+        for (int m = 0; m < GAME_MODE_COUNT; m++) {
+            GameMode mode = static_cast<GameMode>(m);
+            const long long* counts = total.outcomes[m];
+            cout << left << setw(20) << GameEngine::getGameModeName(mode) << right << setw(8) << targetFor(mode);
+            for (int o = 0; o < OUTCOME_COUNT; o++) {
+                cout << setw(o == OUTCOME_COUNT - 1 ? 11 : 9)
+                     << (mode == GameMode::PATTERN_CREATION ? "n/a" : percent(counts[o], total.soups));
+            }
+            cout << "\n";
+        }
+        
+        showRanked("Survival Goal (longest lifespan)", "", total.bestSurvival);
+        showRanked("Population Target (longest run in range up to the target)", "generations in range",
+                   total.bestPopulation);
+    }
+    
+    // The search with every worker playing its soups on a Board
+    template <typename Board>
+    void runOn(const string& boardName) {
+        ThreadPool pool(settings.threads);
+        const int workers = pool.getThreadCount();
+        vector<PuzzleRun<Board>> games(workers, PuzzleRun<Board>(settings.rows, settings.cols, settings.rule));
+        vector<Tally> tallies(workers);
+        
+        cout << "Searching " << settings.soups << " soups on " << workers << " threads with a " << boardName << "...\n";
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        const long long batches = (settings.soups + BATCH_SOUPS - 1) / BATCH_SOUPS;
+        long long batchesDone = 0;
+        while (batchesDone < batches) {
+            int round = static_cast<int>(min<long long>(batches - batchesDone, static_cast<long long>(workers) * ROUND_BATCHES));
+            pool.parallelFor(round, [&](int task, int worker) {
+                long long first = (batchesDone + task) * BATCH_SOUPS;
+                long long last = min(first + BATCH_SOUPS, settings.soups);
+                SoupResult result;
+                for (long long i = first; i < last; i++) {
+                    uint64_t seed = settings.seed + static_cast<uint64_t>(i);
+                    runSoup(games[worker], seed, result);
+                    record(tallies[worker], seed, result);
+                }
+            });
+            batchesDone += round;
+            cout << "\rSearched " << min(batchesDone * BATCH_SOUPS, settings.soups) << "/" << settings.soups << " soups"
+                 << flush;
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "\n";
+        
+        Tally total;
+        for (const Tally& part : tallies) {
+            merge(total, part);
+        }
+        report(total, workers, seconds);
+    }
+    
+    // Play on a compiled board when the search is Rows x Cols
+    template <int Rows, int Cols>
+    bool runFixed() {
+        if (settings.rows != Rows || settings.cols != Cols) {
+            return false;
+        }
+        runOn<FixedGrid<Rows, Cols>>("fixed " + to_string(Rows) + "x" + to_string(Cols) + " board");
+        return true;
+    }
+    
+    // Play one soup on a Board and check it settles into a cycle when expected
+    template <typename Board>
+    bool checkSoup(const string& boardName, uint64_t seed, int lifespan, ostream& out) const {
+        PuzzleRun<Board> game(settings.rows, settings.cols, settings.rule);
+        SoupResult result;
+        runSoup(game, seed, result);
+        bool passed = result.settled && !result.died && result.lifespan == lifespan;
+        out << "  Soup " << seed << " on a " << boardName << ": "
+            << (passed ? "OK" : "FAILED") << " (lifespan " << result.lifespan
+            << (result.settled ? ", settled" : ", unsettled") << ")\n";
+        return passed;
+    }
+    
+public:
+    explicit SoupSearch(const SearchSettings& searchSettings) : settings(searchSettings) {}
+    
+    // Seed 2556 of a 16x16 search enters a period-64 glider cycle at
+    // generation 546, after the last power of two below the generation cap,
+    // where a checkpoint that doubles its span would never match it
+    static bool runSelfCheck(ostream& out) {
+        const uint64_t LATE_CYCLE_SEED = 2556;
+        const int LATE_CYCLE_START = 546;
+        SoupSearch search{SearchSettings()};
+        bool fixedPassed = search.checkSoup<FixedGrid<16, 16>>("fixed board", LATE_CYCLE_SEED, LATE_CYCLE_START, out);
+        bool dynamicPassed = search.checkSoup<Grid>("dynamic board", LATE_CYCLE_SEED, LATE_CYCLE_START, out);
+        return fixedPassed && dynamicPassed;
+    }
+    
+    // Sizes without a compiled board are played on the dynamic Grid
+    void run() {
+        if (!runFixed<8, 8>() && !runFixed<16, 16>() && !runFixed<DEFAULT_ROWS, DEFAULT_COLS>() &&
+            !runFixed<32, 32>() && !runFixed<64, 64>()) {
+            runOn<Grid>("dynamic board");
+        }
+    }
+};
+
+// Settings of a headless puzzle solve (--solve)
+struct SolveSettings {
+    GameMode mode = GameMode::POPULATION_TARGET;
+    int rows = DEFAULT_ROWS;  // Board the puzzle is played on
+    int cols = DEFAULT_COLS;
+    int boxRows = 6;          // Cells may only be placed in a box this size in the middle of the board
+    int boxCols = 6;
+    int maxCells = 0;         // Most cells a solution may place, 0 for no limit
+    int target = 0;           // Generations the game is played to, 0 for the menu's target for the mode
+    double density = 0.3;     // Of the random box each restart begins from
+    uint64_t seed = 1;        // Worker w draws its moves from seed + w
+    double timeLimit = 10.0;  // Seconds before giving up
+    int threads = 0;
+    life::Rule rule = life::CONWAY;
+};
+
+// Randomized local search for a starting board that wins a puzzle
+//
+// The player may only place cells inside a box in the middle of the board, so
+// the candidates are the configurations of that box. Every worker starts
+// from a random box and flips one cell at a time. A flip that leaves the
+// configuration no further from a win is kept, and one in WORSE_ODDS worse
+// ones is kept too, to get off plateaus. After STALL_MOVES flips without a
+// new best the worker restarts from a fresh random box. The distance from a
+// win follows the game's own checks:
+//  - Population Target: how early the board died, or how far the population
+//    at the target generation is from the range.
+//  - Pattern Creation: 0 once a glider appears by the target generation, else
+//    fewer the more generations the board stayed active, since gliders come
+//    out of long-lived chaos.
+//
+// A flip is scored without replaying the whole game. Each worker keeps every
+// generation of its current configuration. By generation t a flipped cell can
+// only have changed rows next to rows that differed at t - 1, so only those
+// are recomputed, and once a generation comes out equal to the stored one the
+// rest of the run is known. Scores are memoized across workers by the hash of
+// the box's canonical form (census.hpp). Translations and reflections of a
+// configuration play out the same on the torus, and so do rotations when it
+// is square, so each shape is simulated once. A win is replayed from scratch
+// before it is reported.
+//
+// Which solution turns up first depends on how the workers interleave, so
+// runs with several threads may report different ones.
+class PatternSolver {
+private:
+    static const int STALL_MOVES = 4000;
+    static const int WORSE_ODDS = 32;
+    static const int LOSS_SCORE = 1000;  // Added to a score when the board dies out
+    static const int MEMO_SHARDS = 64;
+    
+    // Every generation of one configuration's game, up to the target
+    struct Run {
+        vector<BitGrid> frames;      // frames[t] is generation t
+        vector<int> population;
+        vector<signed char> glider;  // Census result per generation, -1 until taken
+    };
+    
+    struct Worker {
+        mt19937 gen;
+        life::PatternCensus census;
+        Run current;
+        Run trial;
+        vector<char> differs;    // Rows of the trial that differ from current this generation
+        vector<char> recompute;  // Rows to step this generation
+        vector<vector<int>> changedRows;  // Per generation, the only rows where trial and current differ
+        vector<pair<int, int>> cells;
+        long long evaluations = 0;
+        long long memoHits = 0;
+        long long replays = 0;      // Games simulated, in full or in part
+        long long rowsStepped = 0;
+    };
+    
+    struct MemoShard {
+        mutex lock;
+        unordered_map<uint64_t, int> scores;
+    };
+    
+    SolveSettings settings;
+    int target;           // Generations the game is played to
+    int boxTop;
+    int boxLeft;
+    int orientations;     // Of canonicalForm: all 8 on a square board, else the reflections
+    life::RuleKernel kernel;
+    vector<MemoShard> memo;
+    atomic<bool> solved;
+    mutex solutionLock;
+    BitGrid solution;
+    
+    void resizeRun(Run& run) const {
+        run.frames.assign(target + 1, BitGrid(settings.rows, settings.cols));
+        run.population.assign(target + 1, 0);
+        run.glider.assign(target + 1, -1);
+    }
+    
+    // A random box, with at most maxCells cells
+    void fillBox(BitGrid& board, mt19937& gen) const {
+        uniform_real_distribution<> dis(0.0, 1.0);
+        board.clear();
+        int placed = 0;
+        for (int r = 0; r < settings.boxRows; r++) {
+            for (int c = 0; c < settings.boxCols; c++) {
+                if (dis(gen) < settings.density && (settings.maxCells == 0 || placed < settings.maxCells)) {
+                    board.set(boxTop + r, boxLeft + c, true);
+                    placed++;
+                }
+            }
+        }
+    }
+    
+    // Memo key of the box: equal for configurations that play out the same
+    uint64_t memoKey(const BitGrid& board, vector<pair<int, int>>& cells) const {
+        cells.clear();
+        for (int r = 0; r < settings.boxRows; r++) {
+            for (int c = 0; c < settings.boxCols; c++) {
+                if (board.get(boxTop + r, boxLeft + c)) {
+                    cells.push_back(make_pair(r, c));
+                }
+            }
+        }
+        return hash<string>()(life::canonicalForm(cells, orientations));
+    }
+    
+    bool recall(uint64_t key, int& score) {
+        MemoShard& shard = memo[key % MEMO_SHARDS];
+        lock_guard<mutex> guard(shard.lock);
+        auto it = shard.scores.find(key);
+        if (it == shard.scores.end()) {
+            return false;
+        }
+        score = it->second;
+        return true;
+    }
+    
+    void remember(uint64_t key, int score) {
+        MemoShard& shard = memo[key % MEMO_SHARDS];
+        lock_guard<mutex> guard(shard.lock);
+        shard.scores.emplace(key, score);
+    }
+    
+    // Play the game of run.frames[0] through to the target
+    void simulate(Worker& worker, Run& run) const {
+        const BitGrid& first = run.frames[0];
+        run.population[0] = first.popcount();
+        run.glider[0] = -1;
+        for (int t = 1; t <= target; t++) {
+            kernel(run.frames[t - 1], run.frames[t], 0, settings.rows, 0, first.getWordsPerRow());
+            run.population[t] = run.frames[t].popcount();
+            run.glider[t] = -1;
+        }
+        worker.replays++;
+        worker.rowsStepped += static_cast<long long>(settings.rows) * target;
+    }
+    
+    // Make worker.trial a copy of worker.current, after current was simulated afresh
+    void matchTrial(Worker& worker) const {
+        Run& trial = worker.trial;
+        trial.frames = worker.current.frames;
+        trial.population = worker.current.population;
+        trial.glider = worker.current.glider;
+        for (vector<int>& changed : worker.changedRows) {
+            changed.clear();
+        }
+    }
+    
+    // worker.trial becomes worker.current with cell (row, col) flipped,
+    // stepping only the rows the flip can have reached. The trial only ever
+    // differs from current in worker.changedRows, so putting those rows back
+    // is all it takes to start over, and the frames after the flip died out
+    // are never touched. Swapping trial and current keeps this true.
+    void resimulate(Worker& worker, int row, int col) const {
+        const Run& current = worker.current;
+        Run& trial = worker.trial;
+        const int rows = settings.rows;
+        const int words = current.frames[0].getWordsPerRow();
+        for (int t = 0; t <= target; t++) {
+            for (int r : worker.changedRows[t]) {
+                copy(current.frames[t].row(r), current.frames[t].row(r) + words, trial.frames[t].row(r));
+            }
+            worker.changedRows[t].clear();
+        }
+        
+        bool alive = !current.frames[0].get(row, col);
+        trial.frames[0].set(row, col, alive);
+        worker.changedRows[0].push_back(row);
+        trial.population[0] = current.population[0] + (alive ? 1 : -1);
+        trial.glider[0] = -1;
+        worker.replays++;
+        fill(worker.differs.begin(), worker.differs.end(), 0);
+        worker.differs[row] = 1;
+        
+        for (int t = 1; t <= target; t++) {
+            for (int r = 0; r < rows; r++) {
+                worker.recompute[r] = worker.differs[(r + rows - 1) % rows] | worker.differs[r] |
+                                      worker.differs[(r + 1) % rows];
+            }
+            fill(worker.differs.begin(), worker.differs.end(), 0);
+            int population = current.population[t];
+            bool changed = false;
+            for (int r = 0; r < rows;) {
+                if (!worker.recompute[r]) {
+                    r++;
+                    continue;
+                }
+                int end = r;
+                while (end < rows && worker.recompute[end]) end++;
+                kernel(trial.frames[t - 1], trial.frames[t], r, end, 0, words);
+                worker.rowsStepped += end - r;
+                for (; r < end; r++) {
+                    const uint64_t* was = current.frames[t].row(r);
+                    const uint64_t* now = trial.frames[t].row(r);
+                    for (int w = 0; w < words; w++) {
+                        if (was[w] != now[w]) {
+                            population += __builtin_popcountll(now[w]) - __builtin_popcountll(was[w]);
+                            worker.differs[r] = 1;
+                        }
+                    }
+                    if (worker.differs[r]) {
+                        worker.changedRows[t].push_back(r);
+                        changed = true;
+                    }
+                }
+            }
+            trial.population[t] = population;
+            trial.glider[t] = changed ? -1 : current.glider[t];
+            
+            // The flip has died out: the rest of the game is the stored one
+            if (!changed) {
+                for (int u = t + 1; u <= target; u++) {
+                    trial.population[u] = current.population[u];
+                    trial.glider[u] = current.glider[u];
+                }
+                break;
+            }
+        }
+    }
+    
+    // How far the game of run is from a win, 0 if it wins
+    int score(Worker& worker, Run& run) const {
+        if (settings.mode == GameMode::POPULATION_TARGET) {
+            for (int t = 0; t <= target; t++) {
+                if (run.population[t] == 0) {
+                    return LOSS_SCORE + target - t;
+                }
+            }
+            int population = run.population[target];
+            return population < POPULATION_TARGET_MIN ? POPULATION_TARGET_MIN - population
+                 : population > POPULATION_TARGET_MAX ? population - POPULATION_TARGET_MAX : 0;
+        }
+        
+        // Pattern Creation: the census is only taken where the board moved
+        int active = 0;
+        for (int t = 0; t <= target; t++) {
+            if (run.glider[t] < 0) {
+                if (t > 0 && run.frames[t] == run.frames[t - 1]) {
+                    run.glider[t] = run.glider[t - 1];
+                } else {
+                    run.glider[t] = run.population[t] >= 5 && worker.census.contains(run.frames[t], "glider");
+                }
+            }
+            if (run.glider[t]) {
+                return 0;
+            }
+            if (t >= 2 && run.frames[t] != run.frames[t - 2]) {
+                active++;
+            }
+        }
+        return 1 + target - active;
+    }
+    
+    // Score the configuration in run.frames[0] from scratch, through the memo
+    int evaluate(Worker& worker, Run& run) {
+        simulate(worker, run);
+        int result = score(worker, run);
+        remember(memoKey(run.frames[0], worker.cells), result);
+        return result;
+    }
+    
+    void search(Worker& worker, chrono::steady_clock::time_point deadline) {
+        uniform_int_distribution<int> pickRow(0, settings.boxRows - 1);
+        uniform_int_distribution<int> pickCol(0, settings.boxCols - 1);
+        while (!solved.load(memory_order_relaxed) && chrono::steady_clock::now() < deadline) {
+            fillBox(worker.current.frames[0], worker.gen);
+            int currentScore = evaluate(worker, worker.current);
+            matchTrial(worker);
+            worker.evaluations++;
+            int best = currentScore;
+            int stall = 0;
+            while (currentScore > 0 && stall < STALL_MOVES && !solved.load(memory_order_relaxed) &&
+                   chrono::steady_clock::now() < deadline) {
+                int row = boxTop + pickRow(worker.gen);
+                int col = boxLeft + pickCol(worker.gen);
+                BitGrid& board = worker.current.frames[0];
+                bool alive = board.get(row, col);
+                if (!alive && settings.maxCells > 0 && worker.current.population[0] >= settings.maxCells) {
+                    continue;
+                }
+                worker.evaluations++;
+                bool keepWorse = worker.gen() % WORSE_ODDS == 0;
+                
+                // A shape already scored worse is not simulated again
+                board.set(row, col, !alive);
+                uint64_t key = memoKey(board, worker.cells);
+                board.set(row, col, alive);
+                int known;
+                bool recalled = recall(key, known);
+                if (recalled) {
+                    worker.memoHits++;
+                    if (known > currentScore && !keepWorse) {
+                        stall++;
+                        continue;
+                    }
+                }
+                
+                resimulate(worker, row, col);
+                int trialScore = score(worker, worker.trial);
+                if (!recalled) {
+                    remember(key, trialScore);
+                }
+                if (trialScore <= currentScore || keepWorse) {
+                    swap(worker.current, worker.trial);
+                    currentScore = trialScore;
+                }
+                if (currentScore < best) {
+                    best = currentScore;
+                    stall = 0;
+                } else {
+                    stall++;
+                }
+            }
+            
+            if (currentScore == 0) {
+                lock_guard<mutex> guard(solutionLock);
+                if (!solved.load()) {
+                    solution = worker.current.frames[0];
+                    solved.store(true);
+                }
+            }
+        }
+    }
+    
+    // The box of board as a pattern of its own
+    BitGrid boxOf(const BitGrid& board) const {
+        BitGrid box(settings.boxRows, settings.boxCols);
+        for (int r = 0; r < settings.boxRows; r++) {
+            for (int c = 0; c < settings.boxCols; c++) {
+                box.set(r, c, board.get(boxTop + r, boxLeft + c));
+            }
+        }
+        return box;
+    }
+    
+public:
+    explicit PatternSolver(const SolveSettings& solveSettings)
+        : settings(solveSettings),
+          target(solveSettings.target > 0 ? solveSettings.target
+                 : solveSettings.mode == GameMode::PATTERN_CREATION ? PATTERN_CREATION_GENERATIONS
+                                                                    : POPULATION_TARGET_GENERATIONS),
+          boxTop((solveSettings.rows - solveSettings.boxRows) / 2),
+          boxLeft((solveSettings.cols - solveSettings.boxCols) / 2),
+          orientations(solveSettings.rows == solveSettings.cols ? 8 : 4),
+          kernel(life::fastRuleKernel(solveSettings.rule)), memo(MEMO_SHARDS), solved(false),
+          solution(solveSettings.rows, solveSettings.cols) {}
+    
+    // Search until a solution turns up or the time limit passes; false if none did
+    bool run() {
+        ThreadPool pool(settings.threads);
+        const int threads = pool.getThreadCount();
+        vector<Worker> workers(threads);
+        for (int w = 0; w < threads; w++) {
+            workers[w].gen = life::soupGenerator(settings.seed + static_cast<uint64_t>(w));
+            resizeRun(workers[w].current);
+            resizeRun(workers[w].trial);
+            workers[w].differs.assign(settings.rows, 0);
+            workers[w].recompute.assign(settings.rows, 0);
+            workers[w].changedRows.assign(target + 1, vector<int>());
+        }
+        
+        cout << "Solving " << GameEngine::getGameModeName(settings.mode) << " to generation " << target << " on a "
+             << settings.rows << "x"
+             << settings.cols << " torus, cells only in the " << settings.boxRows << "x" << settings.boxCols
+             << " box at (" << boxTop << ", " << boxLeft << ")";
+        if (settings.maxCells > 0) {
+            cout << ", at most " << settings.maxCells << " cells";
+        }
+        cout << ", rule " << life::ruleString(settings.rule) << ", on " << threads << " threads...\n";
+        
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        chrono::steady_clock::time_point deadline =
+            start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(settings.timeLimit));
+        pool.parallelFor(threads, [&](int task, int) { search(workers[task], deadline); });
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        
+        long long evaluations = 0, memoHits = 0, replays = 0, rowsStepped = 0;
+        for (const Worker& worker : workers) {
+            evaluations += worker.evaluations;
+            memoHits += worker.memoHits;
+            replays += worker.replays;
+            rowsStepped += worker.rowsStepped;
+        }
+        cout << "Time: " << fixed << setprecision(2) << seconds << " s | Configurations: " << evaluations
+             << " (" << setprecision(1) << (evaluations > 0 ? 100.0 * memoHits / evaluations : 0.0)
+             << "% from the memo) | Rows stepped: "
+             << (replays > 0 ? 100.0 * rowsStepped / (static_cast<double>(replays) * settings.rows * target) : 0.0)
+             << "% of full replays\n";
+        cout.unsetf(ios::floatfield);
+        
+        if (!solved.load()) {
+            cout << "No solution found within " << settings.timeLimit << " s.\n";
+            return false;
+        }
+        
+        // Certify the solution by playing it again from scratch
+        Worker& check = workers[0];
+        check.current.frames[0] = solution;
+        if (evaluate(check, check.current) != 0) {
+            cout << "Solution failed its replay.\n";
+            return false;
+        }
+        int wonAt = target;
+        if (settings.mode == GameMode::PATTERN_CREATION) {
+            wonAt = static_cast<int>(find(check.current.glider.begin(), check.current.glider.end(), 1) -
+                                     check.current.glider.begin());
+        }
+        cout << "Solved with " << solution.popcount() << " cells: "
+             << (settings.mode == GameMode::PATTERN_CREATION ? "a glider at generation " : "population " +
+                 to_string(check.current.population[target]) + " at generation ") << wonAt << ".\n";
+        cout << "Load it with its top-left cell at (" << boxTop << " " << boxLeft << "):\n";
+        life::writeRle(cout, boxOf(solution), life::ruleString(settings.rule));
+        return true;
+    }
+};
+
+// Settings of a headless out-of-core run (--stream)
+struct StreamSettings {
+    string input;
+    string output;                        // Defaults to the input's name with .out.snap
+    long long generations = 100;
+    int depth = OutOfCoreStepper::DEFAULT_DEPTH;
+    size_t bandBytes = OutOfCoreStepper::DEFAULT_BAND_BYTES;
+    int soupRows = 0;                     // With a size, the input is first written as a random soup
+    int soupCols = 0;
+    double density = 0.3;
+    uint64_t seed = 1;
+    int threads = 0;
+    int rankRows = 0;                     // With a PxQ split, the board is run by P*Q processes instead
+    int rankCols = 0;
+    life::Rule rule = life::CONWAY;
+};
+
+// Run the board as one process per block, exchanging halos over loopback
+int runDistributed(const StreamSettings& settings) {
+    const int ranks = settings.rankRows * settings.rankCols;
+    int threads = settings.threads > 0 ? settings.threads
+                                       : max(1, static_cast<int>(thread::hardware_concurrency()) / ranks);
+    cout << "Running " << settings.input << " for " << settings.generations << " generations on "
+         << settings.rankRows << "x" << settings.rankCols << " processes (" << threads << " threads each, rule "
+         << life::ruleString(settings.rule) << ")\n";
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<BlockStepper::Result> results;
+    string error;
+    if (!DistributedRun::runLocal(settings.input, settings.output, settings.generations, settings.rankRows,
+                                  settings.rankCols, threads, settings.rule, results, error)) {
+        cout << "Distributed run error: " << error << "\n";
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    long long population = 0;
+    for (const BlockStepper::Result& result : results) {
+        population += result.population;
+        cout << "Rank " << result.rank << ": " << result.population << " cells, " << fixed << setprecision(2)
+             << result.seconds << " s, " << result.waitSeconds << " s waiting on neighbours\n";
+    }
+    MappedBoardFile result;
+    if (!result.open(settings.output, false, error)) {
+        cout << "Distributed run error: " << error << "\n";
+        return 1;
+    }
+    double cells = static_cast<double>(result.getRows()) * result.getCols() * settings.generations;
+    cout << "Wrote generation " << result.getInfo().generation << " (" << population << " cells) to "
+         << settings.output << " in " << seconds << " s (" << (seconds > 0 ? cells / seconds / 1e9 : 0.0)
+         << " Gcell updates/s)\n";
+    return 0;
+}
+
+// Run a board kept on disk from one snapshot file to another, for boards
+// that do not fit in memory
+int runOutOfCore(StreamSettings settings) {
+    if (settings.output.empty()) {
+        string stem = life::isSnapshotFile(settings.input) ? settings.input.substr(0, settings.input.size() - 5)
+                                                           : settings.input;
+        settings.output = stem + ".out.snap";
+    }
+    string error;
+    if (settings.soupRows > 0) {
+        cout << "Writing a " << settings.soupRows << "x" << settings.soupCols << " soup to " << settings.input << "...\n";
+        if (!OutOfCoreStepper::createSoup(settings.input, settings.soupRows, settings.soupCols, settings.density,
+                                          settings.seed, settings.rule, error)) {
+            cout << "Stream error: " << error << "\n";
+            return 1;
+        }
+    }
+    
+    if (settings.rankRows > 0) {
+        return runDistributed(settings);
+    }
+    
+    ThreadPool pool(settings.threads);
+    OutOfCoreStepper stepper(settings.depth, settings.bandBytes);
+    cout << "Streaming " << settings.input << " for " << settings.generations << " generations ("
+         << settings.depth << " per pass, " << pool.getThreadCount() << " threads, rule "
+         << life::ruleString(settings.rule) << ")\n";
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    bool ran = stepper.run(settings.input, settings.output, settings.generations, pool, settings.rule, error,
+        [](long long done, long long total) {
+            cout << "\rGeneration " << done << "/" << total << flush;
+        });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "\n";
+    if (!ran) {
+        cout << "Stream error: " << error << "\n";
+        return 1;
+    }
+    
+    MappedBoardFile result;
+    if (!result.open(settings.output, false, error)) {
+        cout << "Stream error: " << error << "\n";
+        return 1;
+    }
+    double cells = static_cast<double>(result.getRows()) * result.getCols() * settings.generations;
+    cout << "Wrote generation " << result.getInfo().generation << " to " << settings.output << " in "
+         << fixed << setprecision(2) << seconds << " s (" << (seconds > 0 ? cells / seconds / 1e9 : 0.0)
+         << " Gcell updates/s)\n";
+    return 0;
+}
+
 // Main function
-int main() {
+int main(int argc, char* argv[]) {
+    int threads = 0;
+    Topology topology = Topology::TORUS;
+    life::Rule rule = life::CONWAY;
+    bool search = false;
+    SearchSettings searchSettings;
+    bool sizeGiven = false;
+    StreamSettings streamSettings;
+    bool solve = false;
+    SolveSettings solveSettings;
+    bool targetGiven = false;
+    string tracePath;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        // Verify every SIMD kernel against the per-cell reference, and the
+        // soup search against a soup with a known cycle, and exit
+        if (arg == "--self-check") {
+            cout << "Running generation kernel self-check...\n";
+            bool passed = life::runKernelSelfCheck(cout);
+            cout << (passed ? "All kernels match.\n" : "Kernel self-check FAILED.\n");
+            cout << "Checking soup search cycle detection...\n";
+            bool searchPassed = SoupSearch::runSelfCheck(cout);
+            cout << (searchPassed ? "Soup search checks pass.\n" : "Soup search self-check FAILED.\n");
+            return passed && searchPassed ? 0 : 1;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (arg == "--infinite") {
+            topology = Topology::INFINITE_PLANE;
+        } else if (arg == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (arg == "--rule" && i + 1 < argc) {
+            string error;
+            if (!life::parseRule(argv[++i], rule, error)) {
+                cout << "Invalid rule: " << error << "\n";
+                return 1;
+            }
+        // Headless random-soup search and its settings
+        } else if (arg == "--search" && i + 1 < argc) {
+            search = true;
+            searchSettings.soups = atoll(argv[++i]);
+        } else if (arg == "--size" && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &searchSettings.rows, &searchSettings.cols) != 2) {
+                cout << "Invalid size: expected ROWSxCOLS\n";
+                return 1;
+            }
+            sizeGiven = true;
+        } else if (arg == "--density" && i + 1 < argc) {
+            searchSettings.density = atof(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            searchSettings.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--target" && i + 1 < argc) {
+            searchSettings.target = atoi(argv[++i]);
+            targetGiven = true;
+        } else if (arg == "--max-generations" && i + 1 < argc) {
+            searchSettings.maxGenerations = atoi(argv[++i]);
+        } else if (arg == "--top" && i + 1 < argc) {
+            searchSettings.top = atoi(argv[++i]);
+        // Headless puzzle solve and its settings
+        } else if (arg == "--solve" && i + 1 < argc) {
+            string goal = argv[++i];
+            if (goal == "pattern") {
+                solveSettings.mode = GameMode::PATTERN_CREATION;
+            } else if (goal == "population") {
+                solveSettings.mode = GameMode::POPULATION_TARGET;
+            } else {
+                cout << "Invalid goal: expected pattern or population\n";
+                return 1;
+            }
+            solve = true;
+        } else if (arg == "--box" && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &solveSettings.boxRows, &solveSettings.boxCols) != 2) {
+                cout << "Invalid box: expected ROWSxCOLS\n";
+                return 1;
+            }
+        } else if (arg == "--max-cells" && i + 1 < argc) {
+            solveSettings.maxCells = atoi(argv[++i]);
+        } else if (arg == "--time-limit" && i + 1 < argc) {
+            solveSettings.timeLimit = atof(argv[++i]);
+        // Headless out-of-core run of a snapshot file and its settings
+        } else if (arg == "--stream" && i + 1 < argc) {
+            streamSettings.input = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            streamSettings.output = argv[++i];
+        } else if (arg == "--generations" && i + 1 < argc) {
+            streamSettings.generations = atoll(argv[++i]);
+        } else if (arg == "--depth" && i + 1 < argc) {
+            streamSettings.depth = atoi(argv[++i]);
+        } else if (arg == "--ranks" && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &streamSettings.rankRows, &streamSettings.rankCols) != 2 ||
+                streamSettings.rankRows <= 0 || streamSettings.rankCols <= 0) {
+                cout << "Invalid ranks: expected PxQ\n";
+                return 1;
+            }
+        } else if (arg == "--band-mb" && i + 1 < argc) {
+            streamSettings.bandBytes = static_cast<size_t>(atof(argv[++i]) * (1 << 20));
+        }
+    }
+    
+    // Only the search and the solver play a game to a target
+    if (targetGiven && (!streamSettings.input.empty() || (!search && !solve))) {
+        cout << "--target only applies to --search and --solve.\n";
+        return 1;
+    }
+    
+    if (!streamSettings.input.empty()) {
+        if (streamSettings.generations < 0 || streamSettings.depth < 1 || streamSettings.bandBytes == 0 ||
+            (sizeGiven && (searchSettings.rows <= 0 || searchSettings.cols <= 0))) {
+            cout << "Invalid stream settings.\n";
+            return 1;
+        }
+        if (sizeGiven) {
+            streamSettings.soupRows = searchSettings.rows;
+            streamSettings.soupCols = searchSettings.cols;
+        }
+        streamSettings.density = searchSettings.density;
+        streamSettings.seed = searchSettings.seed;
+        streamSettings.threads = threads;
+        streamSettings.rule = rule;
+        return runOutOfCore(streamSettings);
+    }
+    
+    if (solve) {
+        if (sizeGiven) {
+            solveSettings.rows = searchSettings.rows;
+            solveSettings.cols = searchSettings.cols;
+        }
+        if (solveSettings.rows <= 0 || solveSettings.cols <= 0 || solveSettings.boxRows <= 0 ||
+            solveSettings.boxCols <= 0 || solveSettings.boxRows > solveSettings.rows ||
+            solveSettings.boxCols > solveSettings.cols || solveSettings.maxCells < 0 || solveSettings.timeLimit <= 0 ||
+            (targetGiven && searchSettings.target <= 0)) {
+            cout << "Invalid solve settings.\n";
+            return 1;
+        }
+        if (targetGiven) {
+            solveSettings.target = searchSettings.target;
+        }
+        solveSettings.density = searchSettings.density;
+        solveSettings.seed = searchSettings.seed;
+        solveSettings.threads = threads;
+        solveSettings.rule = rule;
+        return PatternSolver(solveSettings).run() ? 0 : 1;
+    }
+    
+    if (search) {
+        if (searchSettings.soups <= 0 || searchSettings.rows <= 0 || searchSettings.cols <= 0 ||
+            searchSettings.target <= 0 || searchSettings.maxGenerations <= 0 || searchSettings.top < 0) {
+            cout << "Invalid search settings.\n";
+            return 1;
+        }
+        searchSettings.threads = threads;
+        searchSettings.rule = rule;
+        SoupSearch(searchSettings).run();
+        return 0;
+    }
+    
+    if (topology == Topology::INFINITE_PLANE && !life::ruleKeepsVoid(rule)) {
+        cout << "Rules with B0 fill empty space, so they need a finite board. Using the torus.\n";
+        topology = Topology::TORUS;
+    }
+    
     int rows, cols;
     cout << "Enter grid dimensions (rows columns): ";
     cin >> rows >> cols;
     
-    if (rows <= 0 || cols <= 0 || rows > 100 || cols > 100) {
+    bool tooLarge = topology == Topology::INFINITE_PLANE
+                        ? rows > MAX_VIEWPORT_SIZE || cols > MAX_VIEWPORT_SIZE
+                        : static_cast<long long>(rows) * cols > MAX_TORUS_CELLS;
+    if (rows <= 0 || cols <= 0 || tooLarge) {
         cout << "Invalid dimensions. Using default 20x40.\n";
         rows = DEFAULT_ROWS;
         cols = DEFAULT_COLS;
     }
     
-    GameController game(rows, cols);
+    // On the infinite plane these are the viewport dimensions
+    GameController game(rows, cols, threads, topology, rule);
+    if (!tracePath.empty()) {
+        game.enableTrace(tracePath);
+    }
     game.run();
     
     return 0;
@@ -8,6 +8,8 @@
 #include <chrono>
 #include <thread>
 #include <cstdlib>
+#include <sstream>
+#include "../Terminal_Renderer/terminal_renderer.hpp"
 
 using namespace std;
 
@@ -19,6 +21,7 @@ private:
     double regrowthProb;
     double lightningProb;
     int stepCount;
+    TerminalRenderer screen;  // Redraws only the cells that changed between frames
     
     // Random number generation
     random_device rd;
@@ -164,7 +167,6 @@ public:
         
         while (true) {
             displayGrid();
-            displayStats();
             displayMenu();
             
             cin >> choice;
@@ -250,35 +252,38 @@ public:
         
         for (int i = 0; i < steps; i++) {
             stepSimulation();
-            displayGrid();
-            displayStats();
+            displayGrid(i > 0); // The first step follows the prompts
             this_thread::sleep_for(chrono::milliseconds(delay));
         }
     }
     
-    void displayGrid() {
-        system("cls"); // Clear screen (Windows)
+    // Draw the board and its statistics as one frame. An incremental frame only
+    // sends what changed since the last one; others follow prompts that may
+    // have scrolled the screen and are redrawn in full.
+    void displayGrid(bool incremental = false) {
+        if (!incremental) {
+            screen.invalidate();
+        }
+        screen.beginFrame();
         
-        cout << "=== FOREST FIRE SIMULATION ===\n";
-        cout << "Step: " << stepCount << "\n\n";
+        Viewport view = screen.fit(rows, cols, 1, 0, 3, 6);
+        string header = "Step: " + to_string(stepCount);
+        if (view.clipped) {
+            header += " | " + view.label();
+        }
+        screen.line("=== FOREST FIRE SIMULATION ===");
+        screen.line(header);
+        screen.line("");
         
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                switch (grid[i][j]) {
-                    case 'T':
-                        cout << "T";
-                        break;
-                    case 'F':
-                        cout << "F";
-                        break;
-                    case '.':
-                        cout << ".";
-                        break;
-                }
-            }
-            cout << "\n";
+        string line;
+        for (int i = view.firstRow; i < view.firstRow + view.rows; i++) {
+            line.assign(grid[i].begin() + view.firstCol, grid[i].begin() + view.firstCol + view.cols);
+            screen.line(line);
         }
-        cout << "\n";
+        screen.line("");
+        
+        displayStats();
+        screen.present();
     }
     
     void displayStats() {
@@ -294,10 +299,18 @@ public:
             }
         }
         
-        cout << "Statistics:\n";
-        cout << "Trees: " << trees << " (" << (trees * 100.0 / (rows * cols)) << "%)\n";
-        cout << "Burning: " << burning << " (" << (burning * 100.0 / (rows * cols)) << "%)\n";
-        cout << "Empty: " << empty << " (" << (empty * 100.0 / (rows * cols)) << "%)\n\n";
+        screen.line("Statistics:");
+        screen.line(statLine("Trees", trees));
+        screen.line(statLine("Burning", burning));
+        screen.line(statLine("Empty", empty));
+        screen.line("");
+    }
+    
+    // "Trees: 120 (30%)"
+    string statLine(const string& name, int count) {
+        ostringstream text;
+        text << name << ": " << count << " (" << (count * 100.0 / (rows * cols)) << "%)";
+        return text.str();
     }
     
     void displayMenu() {
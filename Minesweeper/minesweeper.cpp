@@ -9,16 +9,9 @@
 #include <cstdlib>
 #include <string>
 #include <sstream>
-
-// Clears the console screen.
-void clearScreen() {
-#ifdef _WIN32
-    system("cls");
-#else
-    // ANSI escape code for clearing screen
-    std::cout << "\033[2J\033[1;1H";
-#endif
-}
+#include <chrono>
+#include <thread>
+#include "../Terminal_Renderer/terminal_renderer.hpp"
 
 // Represents a single cell on the Minesweeper board.
 struct Cell {
@@ -33,7 +26,8 @@ class Board {
 public:
     // Constructor to initialize the board with a given size and number of mines.
     Board(int width, int height, int mines)
-        : width(width), height(height), mineCount(mines), remainingCells(width * height - mines), firstMove(true) {
+        : width(width), height(height), mineCount(mines), remainingCells(width * height - mines), firstMove(true),
+          focusX(0), focusY(0), firstFrame(true) {
         grid.resize(height, std::vector<Cell>(width));
     }
 
@@ -59,6 +53,10 @@ private:
     int remainingCells;
     bool firstMove;
     std::vector<std::vector<Cell>> grid;
+    TerminalRenderer screen;  // Redraws only the cells a move changed
+    int focusX;               // Cell of the last move, kept in view on large boards
+    int focusY;
+    bool firstFrame;          // The first board follows the setup prompts
 
     // Places mines randomly on the board, avoiding the first clicked cell.
     void placeMines(int startX, int startY) {
@@ -134,40 +132,54 @@ private:
         }
     }
 
-    // Prints the current state of the board to the console.
+    // Prints the current state of the board to the console. Only the cells
+    // that changed since the last board are sent: the prompt and any message
+    // under the board fit in the lines the renderer keeps free, so the screen
+    // never scrolls. Boards larger than the terminal show the part around the
+    // last move.
     void printBoard() {
-        clearScreen();
-        std::cout << "   ";
-        for (int x = 0; x < width; ++x) {
-            std::cout << x << " ";
+        if (firstFrame) {
+            screen.invalidate();
+            firstFrame = false;
         }
-        std::cout << std::endl;
-        std::cout << "  ";
-        for (int x = 0; x < width; ++x) {
-            std::cout << "--";
+        screen.beginFrame();
+
+        int labelWidth = static_cast<int>(std::to_string(height - 1).size()) + 2;
+        Viewport view = screen.fit(height, width, 2, labelWidth, 3, 0);
+        view = screen.fit(height, width, 2, labelWidth, 3, 0, focusY - view.rows / 2, focusX - view.cols / 2);
+        if (view.clipped) {
+            screen.line(view.label());
         }
-        std::cout << std::endl;
 
+        std::string line = "   ";
+        std::string rule = "  ";
+        for (int x = view.firstCol; x < view.firstCol + view.cols; ++x) {
+            line += std::to_string(x) + " ";
+            rule += "--";
+        }
+        screen.line(line);
+        screen.line(rule);
 
-        for (int y = 0; y < height; ++y) {
-            std::cout << y << " |";
-            for (int x = 0; x < width; ++x) {
+        for (int y = view.firstRow; y < view.firstRow + view.rows; ++y) {
+            line = std::to_string(y) + " |";
+            for (int x = view.firstCol; x < view.firstCol + view.cols; ++x) {
                 if (grid[y][x].isRevealed) {
                     if (grid[y][x].isMine) {
-                        std::cout << "* ";
+                        line += "* ";
                     } else if (grid[y][x].adjacentMines > 0) {
-                        std::cout << grid[y][x].adjacentMines << " ";
+                        line += std::to_string(grid[y][x].adjacentMines) + " ";
                     } else {
-                        std::cout << ". ";
+                        line += ". ";
                     }
                 } else if (grid[y][x].isFlagged) {
-                    std::cout << "F ";
+                    line += "F ";
                 } else {
-                    std::cout << "# ";
+                    line += "# ";
                 }
             }
-            std::cout << std::endl;
+            screen.line(line);
         }
+        screen.present();
     }
 
     // Prompts the user for their move and processes it.
@@ -190,11 +202,11 @@ private:
         } else {
             std::cout << "Invalid command. Please try again." << std::endl;
             // Add a small delay so the user can see the message
-            #ifdef _WIN32
-                system("timeout /t 1 /nobreak >nul");
-            #else
-                system("sleep 1");
-            #endif
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+        if (isValid(c, r)) {
+            focusX = c;
+            focusY = r;
         }
     }
 
@@ -0,0 +1,321 @@
+// Differential ANSI terminal renderer shared by the console games
+//
+// A game draws each frame into a back buffer, one line of characters per
+// screen row, and present() compares it with the front buffer (what the screen
+// shows) and sends only the runs that changed, each behind a cursor move, in a
+// single write(). Nothing is cleared and no shell is started, so an
+// auto-running board costs a few bytes per changed cell instead of a process
+// spawn and a full reprint per frame.
+//
+// The frame is drawn from the top of the screen and the cursor is left on the
+// line below it with the rest of the screen erased, so prompts printed with
+// cout appear under the board. Output that scrolls the screen leaves it out of
+// step with the front buffer: call invalidate() after talking to the user and
+// the next frame is redrawn in full (still in a single write).
+//
+// Boards larger than the terminal are shown through a Viewport that fits as
+// many rows and columns as the screen holds below the header, keeping
+// RESERVED_LINES free for prompts.
+//
+// Lines are compared one character (code point) per column. A line holding a
+// symbol that may be drawn two columns wide (U+2600 and up, i.e. emoji) is
+// rewritten whole whenever it changes, as its columns cannot be trusted.
+// When the output is not a terminal, each frame is written as plain lines.
+
+#ifndef TERMINAL_RENDERER_HPP
+#define TERMINAL_RENDERER_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#else
+#include <cerrno>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+// The part of a board shown on screen
+struct Viewport {
+    int firstRow;
+    int firstCol;
+    int rows;
+    int cols;
+    bool clipped;  // Some of the board is off screen
+
+    // "Rows a-b, columns c-d" for a header when clipped, else empty
+    std::string label() const {
+        if (!clipped) {
+            return "";
+        }
+        return "Rows " + std::to_string(firstRow) + "-" + std::to_string(firstRow + rows - 1) +
+               ", columns " + std::to_string(firstCol) + "-" + std::to_string(firstCol + cols - 1);
+    }
+};
+
+class TerminalRenderer {
+public:
+    static const int RESERVED_LINES = 4;  // Lines kept free below a fitted board for prompts
+
+private:
+    std::vector<std::u32string> front;  // What the screen shows
+    std::vector<std::u32string> back;   // The frame being drawn
+    bool terminal;    // Output is an ANSI terminal
+    int width;        // Screen size, 0 when unknown
+    int height;
+    bool fullRedraw;  // The screen no longer matches front
+    std::string out;  // Bytes of the frame being presented, reused between frames
+
+    static bool querySize(int& rows, int& cols) {
+#ifdef _WIN32
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+            return false;
+        }
+        rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+        cols = info.srWindow.Right - info.srWindow.Left + 1;
+        return true;
+#else
+        struct winsize size;
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_row == 0 || size.ws_col == 0) {
+            return false;
+        }
+        rows = size.ws_row;
+        cols = size.ws_col;
+        return true;
+#endif
+    }
+
+    static void decode(const std::string& text, std::u32string& glyphs) {
+        glyphs.clear();
+        for (std::size_t i = 0; i < text.size();) {
+            unsigned char lead = static_cast<unsigned char>(text[i]);
+            int extra = lead < 0x80 ? 0 : lead < 0xE0 ? 1 : lead < 0xF0 ? 2 : 3;
+            char32_t code = extra == 0 ? lead : lead & (0x3F >> extra);
+            for (int k = 1; k <= extra && i + k < text.size(); k++) {
+                code = (code << 6) | (static_cast<unsigned char>(text[i + k]) & 0x3F);
+            }
+            glyphs.push_back(code);
+            i += extra + 1;
+        }
+    }
+
+    void encode(char32_t code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    static char32_t glyphAt(const std::u32string& line, std::size_t col) {
+        return col < line.size() ? line[col] : U' ';
+    }
+
+    static bool mayBeWide(const std::u32string& line) {
+        for (char32_t code : line) {
+            if (code >= 0x2600) return true;
+        }
+        return false;
+    }
+
+    void moveTo(std::size_t row, std::size_t col) {
+        out += "\x1b[" + std::to_string(row + 1) + ";" + std::to_string(col + 1) + "H";
+    }
+
+    // Append the changed runs of one line; runs closer together than a cursor
+    // move costs are sent as one
+    void diffLine(std::size_t row, const std::u32string& was, const std::u32string& now) {
+        const std::size_t MERGE_GAP = 8;
+        std::size_t length = std::max(was.size(), now.size());
+        if ((mayBeWide(was) || mayBeWide(now)) && was != now) {
+            moveTo(row, 0);
+            for (char32_t code : now) encode(code);
+            out += "\x1b[K";
+            return;
+        }
+
+        std::size_t col = 0;
+        while (col < length) {
+            if (glyphAt(was, col) == glyphAt(now, col)) {
+                col++;
+                continue;
+            }
+            std::size_t start = col;
+            std::size_t end = col + 1;  // One past the last changed column of the run
+            for (std::size_t c = end; c < length && c < end + MERGE_GAP; c++) {
+                if (glyphAt(was, c) != glyphAt(now, c)) {
+                    end = c + 1;
+                }
+            }
+            moveTo(row, start);
+            for (std::size_t c = start; c < end; c++) {
+                encode(glyphAt(now, c));
+            }
+            col = end;
+        }
+    }
+
+    void writeOut() {
+        std::cout.flush();
+        std::fflush(stdout);
+#ifdef _WIN32
+        HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
+        std::size_t done = 0;
+        while (done < out.size()) {
+            DWORD written = 0;
+            if (!WriteFile(handle, out.data() + done, static_cast<DWORD>(out.size() - done), &written, NULL) || written == 0) {
+                return;
+            }
+            done += written;
+        }
+#else
+        std::size_t done = 0;
+        while (done < out.size()) {
+            ssize_t written = ::write(STDOUT_FILENO, out.data() + done, out.size() - done);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return;
+            }
+            done += static_cast<std::size_t>(written);
+        }
+#endif
+    }
+
+public:
+    TerminalRenderer() : terminal(false), width(0), height(0), fullRedraw(true) {
+#ifdef _WIN32
+        HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        terminal = GetConsoleMode(handle, &mode) &&
+                   SetConsoleMode(handle, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#else
+        terminal = isatty(STDOUT_FILENO) != 0;
+#endif
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // Redraw everything on the next present(), e.g. after prompts or menus
+    // may have scrolled the screen
+    void invalidate() { fullRedraw = true; }
+
+    // Start a new, empty frame sized to the current screen
+    void beginFrame() {
+        back.clear();
+        int rows = 0, cols = 0;
+        if (!terminal || !querySize(rows, cols)) {
+            rows = cols = 0;
+        }
+        if (rows != height || cols != width) {
+            height = rows;
+            width = cols;
+            fullRedraw = true;
+        }
+    }
+
+    // Draw text with its first character at (row, col) of the frame. Text past
+    // the right edge, or on the screen's last row (kept for the cursor), is cut off.
+    void text(int row, int col, const std::string& utf8) {
+        if (row < 0 || col < 0 || (height > 0 && row >= height - 1)) {
+            return;
+        }
+        static thread_local std::u32string glyphs;
+        decode(utf8, glyphs);
+        std::size_t start = static_cast<std::size_t>(col);
+        if (width > 0) {
+            std::size_t room = col < width ? static_cast<std::size_t>(width - col) : 0;
+            if (glyphs.size() > room) {
+                glyphs.resize(room);
+            }
+        }
+        if (back.size() <= static_cast<std::size_t>(row)) {
+            back.resize(row + 1);
+        }
+        std::u32string& line = back[row];
+        if (line.size() < start + glyphs.size()) {
+            line.resize(start + glyphs.size(), U' ');
+        }
+        std::copy(glyphs.begin(), glyphs.end(), line.begin() + start);
+    }
+
+    // Draw text on a new line below everything drawn so far
+    void line(const std::string& utf8) {
+        std::size_t row = back.size();
+        back.resize(row + 1);
+        text(static_cast<int>(row), 0, utf8);
+    }
+
+    // Lines drawn so far
+    int lineCount() const { return static_cast<int>(back.size()); }
+
+    // The largest part of a boardRows x boardCols board, starting at
+    // (firstRow, firstCol) where possible, that fits on screen with linesAbove
+    // header lines, linesBelow footer lines and RESERVED_LINES for prompts,
+    // when each cell takes cellWidth columns after a labelWidth row label
+    Viewport fit(int boardRows, int boardCols, int cellWidth, int labelWidth, int linesAbove, int linesBelow,
+                 int firstRow = 0, int firstCol = 0) const {
+        int rowsFit = height > 0 ? height - 1 - linesAbove - linesBelow - RESERVED_LINES : boardRows;
+        int colsFit = width > 0 ? (width - labelWidth) / cellWidth : boardCols;
+        Viewport view;
+        view.rows = std::max(1, std::min(boardRows, rowsFit));
+        view.cols = std::max(1, std::min(boardCols, colsFit));
+        view.firstRow = std::max(0, std::min(firstRow, boardRows - view.rows));
+        view.firstCol = std::max(0, std::min(firstCol, boardCols - view.cols));
+        view.clipped = view.rows < boardRows || view.cols < boardCols;
+        return view;
+    }
+
+    // Show the frame: only the changes on a terminal, with one write() call
+    void present() {
+        out.clear();
+        if (!terminal) {
+            for (const std::u32string& row : back) {
+                for (char32_t code : row) encode(code);
+                out += '\n';
+            }
+        } else {
+            if (fullRedraw) {
+                out += "\x1b[H\x1b[2J";
+                front.clear();
+            }
+            std::size_t rows = std::max(front.size(), back.size());
+            static const std::u32string blank;
+            for (std::size_t r = 0; r < rows; r++) {
+                diffLine(r, r < front.size() ? front[r] : blank, r < back.size() ? back[r] : blank);
+            }
+            // Park the cursor under the frame and drop whatever was printed there
+            moveTo(back.size(), 0);
+            out += "\x1b[J";
+        }
+        writeOut();
+        front.swap(back);
+        fullRedraw = false;
+    }
+};
+
+#endif // TERMINAL_RENDERER_HPP
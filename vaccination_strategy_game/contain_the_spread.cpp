@@ -12,6 +12,7 @@
 #include <iomanip>
 #include <string>
 #include <limits>
+#include "../Terminal_Renderer/terminal_renderer.hpp"
 
 using namespace std;
 
@@ -56,6 +57,7 @@ private:
     int totalRecovered;
     int turn;
     int totalCost;
+    TerminalRenderer screen;  // Redraws only the cells that changed between turns
     random_device rd;
     mt19937 gen;
     
@@ -115,44 +117,53 @@ public:
         }
     }
     
-    void displayGrid() {
-        system("cls"); // Clear screen (Windows)
-        
-        cout << "=== CONTAIN THE SPREAD - Vaccination Strategy Game ===" << endl;
-        cout << "Turn: " << turn << endl;
-        cout << "Grid Size: " << width << "x" << height << endl;
-        cout << "Infected: " << totalInfected << " | Vaccinated: " << totalVaccinated 
-             << " | Recovered: " << totalRecovered << endl;
-        cout << "Total Cost: $" << totalCost << " (Vaccinations: $" 
-             << (totalVaccinated * vaccinationCost) << " + Infections: $" 
-             << (totalInfected * infectionPenalty) << ")" << endl;
-        cout << endl;
-        
-        // Display grid (for smaller grids)
-        if (width <= 50 && height <= 30) {
-            for (int y = 0; y < height; y++) {
-                for (int x = 0; x < width; x++) {
-                    switch (grid[y][x].state) {
-                        case CellState::SUSCEPTIBLE:
-                            cout << "S ";
-                            break;
-                        case CellState::INFECTED:
-                            cout << "I ";
-                            break;
-                        case CellState::RECOVERED:
-                            cout << "R ";
-                            break;
-                        case CellState::VACCINATED:
-                            cout << "V ";
-                            break;
-                    }
+    // Draw the turn's frame. An incremental frame only sends what changed since
+    // the last one; others follow prompts and are redrawn in full. Grids larger
+    // than the terminal show the part that fits.
+    void displayGrid(bool incremental = false) {
+        if (!incremental) {
+            screen.invalidate();
+        }
+        screen.beginFrame();
+        
+        Viewport view = screen.fit(height, width, 2, 0, 6, 1);
+        string size = "Grid Size: " + to_string(width) + "x" + to_string(height);
+        if (view.clipped) {
+            size += " | " + view.label();
+        }
+        screen.line("=== CONTAIN THE SPREAD - Vaccination Strategy Game ===");
+        screen.line("Turn: " + to_string(turn));
+        screen.line(size);
+        screen.line("Infected: " + to_string(totalInfected) + " | Vaccinated: " + to_string(totalVaccinated) +
+                    " | Recovered: " + to_string(totalRecovered));
+        screen.line("Total Cost: $" + to_string(totalCost) + " (Vaccinations: $" +
+                    to_string(totalVaccinated * vaccinationCost) + " + Infections: $" +
+                    to_string(totalInfected * infectionPenalty) + ")");
+        screen.line("");
+        
+        string line;
+        for (int y = view.firstRow; y < view.firstRow + view.rows; y++) {
+            line.clear();
+            for (int x = view.firstCol; x < view.firstCol + view.cols; x++) {
+                switch (grid[y][x].state) {
+                    case CellState::SUSCEPTIBLE:
+                        line += "S ";
+                        break;
+                    case CellState::INFECTED:
+                        line += "I ";
+                        break;
+                    case CellState::RECOVERED:
+                        line += "R ";
+                        break;
+                    case CellState::VACCINATED:
+                        line += "V ";
+                        break;
                 }
-                cout << endl;
             }
-        } else {
-            cout << "Grid too large to display. Use statistics view." << endl;
+            screen.line(line);
         }
-        cout << endl;
+        screen.line("");
+        screen.present();
     }
     
     bool isValidPosition(int x, int y) {
@@ -377,7 +388,9 @@ public:
     
     void playTurn(VaccinationStrategy strategy) {
         turn++;
-        displayGrid();
+        // Automatic strategies print only a few lines under the board, so
+        // later turns redraw just the cells that changed
+        displayGrid(strategy != VaccinationStrategy::MANUAL && turn > 1);
         
         // Vaccination phase
         cout << "--- Vaccination Phase ---" << endl;